@@ -0,0 +1,190 @@
+/**
+ * @file host_shims.cpp
+ * @brief Simulated SHT3x driver and mock socket behind the Zephyr shims
+ */
+
+#include "host_shims.h"
+
+#include "sht3xd_direct_reader.h"
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/net/socket.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+/// State of the simulated SHT3x driver
+struct Sht3xData {
+    uint16_t t_raw;   ///< Latest raw temperature
+    uint16_t rh_raw;  ///< Latest raw humidity
+    uint32_t noise;   ///< LCG state of the random walk
+};
+
+Sht3xData sht3x_data{26214, 29491, 1};  // 25 deg C, 45 %RH
+
+HostShims::MockSocket mock_socket{};
+
+/// Only one socket exists; its descriptor is never a valid Linux one
+constexpr int kMockFd = 1000;
+
+/// Move a raw reading by -1..+1 LSB
+uint16_t walk(uint16_t raw, uint32_t& state) {
+    state = state * 1103515245u + 12345u;
+    return static_cast<uint16_t>(raw + static_cast<int>((state >> 16) % 3) - 1);
+}
+
+/// Bitwise CRC-8 (0x31, init 0xFF) like crc8() of Zephyr's sys/crc.h used by the driver
+uint8_t driverCrc(const uint8_t* data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/// Big-endian word followed by its CRC; the sensor's side of the frame
+void putWord(uint8_t* out, uint16_t word) {
+    out[0] = static_cast<uint8_t>(word >> 8);
+    out[1] = static_cast<uint8_t>(word);
+    out[2] = SHT3xDirectReader::crc8(out, 2);
+}
+
+}  // namespace
+
+const struct device shim_device_sensirion_sht3xd = {"sht3xd@44", &sht3x_data};
+const struct device shim_device_i2c = {"i2c@40005400", &sht3x_data};
+
+namespace HostShims {
+
+MockSocket& socket() {
+    return mock_socket;
+}
+
+void setSensorRaw(uint16_t temperature, uint16_t humidity) {
+    sht3x_data.t_raw = temperature;
+    sht3x_data.rh_raw = humidity;
+}
+
+}  // namespace HostShims
+
+/**
+ * @brief Measure over the simulated bus and check the frame like the sht3xd driver
+ */
+int sensor_sample_fetch(const struct device* dev) {
+    const struct i2c_dt_spec bus = {&shim_device_i2c, 0x44};
+    const uint8_t command[2] = {0x2C, 0x06};
+    uint8_t frame[6];
+    const int rc = i2c_write_read_dt(&bus, command, sizeof(command), frame, sizeof(frame));
+    if (rc != 0) {
+        return rc;
+    }
+    if (driverCrc(&frame[0], 2) != frame[2] || driverCrc(&frame[3], 2) != frame[5]) {
+        return -EIO;
+    }
+
+    auto* data = static_cast<Sht3xData*>(dev->data);
+    data->t_raw = static_cast<uint16_t>((frame[0] << 8) | frame[1]);
+    data->rh_raw = static_cast<uint16_t>((frame[3] << 8) | frame[4]);
+    return 0;
+}
+
+/**
+ * @brief Convert the raw readings like the Zephyr sht3xd driver
+ */
+int sensor_channel_get(const struct device* dev, enum sensor_channel chan,
+                       struct sensor_value* val) {
+    const auto* data = static_cast<const Sht3xData*>(dev->data);
+    if (chan == SENSOR_CHAN_AMBIENT_TEMP) {
+        // val = -45 + 175 * sample / (2^16 - 1)
+        const uint64_t tmp = static_cast<uint64_t>(data->t_raw) * 175U;
+        val->val1 = static_cast<int32_t>(tmp / 0xFFFF) - 45;
+        val->val2 = static_cast<int32_t>(((tmp % 0xFFFF) * 1000000U) / 0xFFFF);
+    } else if (chan == SENSOR_CHAN_HUMIDITY) {
+        // val = 100 * sample / (2^16 - 1)
+        const uint32_t tmp = static_cast<uint32_t>(data->rh_raw) * 100U;
+        val->val1 = static_cast<int32_t>(tmp / 0xFFFF);
+        val->val2 = static_cast<int32_t>((static_cast<uint64_t>(tmp % 0xFFFF) * 1000000U) /
+                                         0xFFFF);
+    } else {
+        return -ENOTSUP;
+    }
+    return 0;
+}
+
+/**
+ * @brief Answer a single-shot measurement command like the SHT3x
+ *
+ * Any 0x24xx/0x2Cxx command takes a new reading (same random walk as
+ * sensor_sample_fetch()) and returns temperature word, CRC, humidity
+ * word, CRC. There is no conversion delay.
+ */
+int i2c_write_read_dt(const struct i2c_dt_spec* spec, const void* write_buf, size_t num_write,
+                      void* read_buf, size_t num_read) {
+    const auto* command = static_cast<const uint8_t*>(write_buf);
+    if (num_write != 2 || (command[0] != 0x24 && command[0] != 0x2C) || num_read > 6) {
+        return -EIO;
+    }
+
+    auto* data = static_cast<Sht3xData*>(spec->bus->data);
+    data->t_raw = walk(data->t_raw, data->noise);
+    data->rh_raw = walk(data->rh_raw, data->noise);
+
+    uint8_t frame[6];
+    putWord(&frame[0], data->t_raw);
+    putWord(&frame[3], data->rh_raw);
+    std::memcpy(read_buf, frame, num_read);
+    return 0;
+}
+
+int zsock_socket(int family, int type, int proto) {
+    (void)family;
+    (void)type;
+    (void)proto;
+    return kMockFd;
+}
+
+int zsock_close(int sock) {
+    (void)sock;
+    return 0;
+}
+
+int zsock_connect(int sock, const struct sockaddr* addr, socklen_t addrlen) {
+    (void)addr;
+    (void)addrlen;
+    if (sock != kMockFd) {
+        errno = EBADF;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Accept the datagram, or refuse it as an exhausted network stack would
+ */
+ssize_t zsock_send(int sock, const void* buf, size_t len, int flags) {
+    (void)flags;
+    if (sock != kMockFd) {
+        errno = EBADF;
+        return -1;
+    }
+
+    HostShims::MockSocket& s = mock_socket;
+    if (s.refuse_every > 0 && (s.sent + s.refused + 1) % s.refuse_every == 0) {
+        s.refused++;
+        errno = EAGAIN;
+        return -1;
+    }
+
+    s.last_len = len < sizeof(s.last) ? len : sizeof(s.last);
+    std::memcpy(s.last, buf, s.last_len);
+    s.sent++;
+    s.bytes += len;
+    return static_cast<ssize_t>(len);
+}
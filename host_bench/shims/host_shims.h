@@ -0,0 +1,46 @@
+/**
+ * @file host_shims.h
+ * @brief Control of the simulated sensor and the mock socket behind the shims
+ *
+ * The application modules only see the Zephyr API of the shim headers.
+ * Host programs use this header to set up what the simulated SHT3x
+ * reports and what the mock socket does with the datagrams.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace HostShims {
+
+/**
+ * @brief Counters and behaviour of the mock socket
+ */
+struct MockSocket {
+    uint64_t sent;          ///< Datagrams accepted
+    uint64_t bytes;         ///< Bytes accepted
+    uint64_t refused;       ///< Datagrams refused with EAGAIN
+    uint32_t refuse_every;  ///< Refuse every Nth datagram, 0 = never
+    uint8_t last[2048];     ///< Copy of the latest accepted datagram
+    size_t last_len;        ///< Length of the latest accepted datagram
+};
+
+/**
+ * @brief Get the mock socket shared by all zsock_*() calls
+ */
+MockSocket& socket();
+
+/**
+ * @brief Set the raw readings of the simulated SHT3x
+ *
+ * Every sensor_sample_fetch() and every I2C measurement command moves the
+ * readings by a few LSB (a slow random walk), like a real sensor at a
+ * steady climate.
+ *
+ * @param temperature Raw temperature ticks (-45 + 175 * raw / 65535 deg C)
+ * @param humidity    Raw humidity ticks (100 * raw / 65535 %RH)
+ */
+void setSensorRaw(uint16_t temperature, uint16_t humidity);
+
+}  // namespace HostShims
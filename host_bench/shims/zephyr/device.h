@@ -0,0 +1,24 @@
+/**
+ * @file device.h
+ * @brief Host shim of the Zephyr device model
+ *
+ * Only the SHT3x sensor and its I2C controller (drivers/i2c.h) exist;
+ * DEVICE_DT_GET_ONE(sensirion_sht3xd) yields the simulated sensor of
+ * host_shims.h.
+ */
+
+#pragma once
+
+struct device {
+    const char* name;  ///< Device name
+    void* data;        ///< Driver state
+};
+
+/// Simulated SHT3x sensor
+extern const struct device shim_device_sensirion_sht3xd;
+
+#define DEVICE_DT_GET_ONE(compat) (&shim_device_##compat)
+
+inline bool device_is_ready(const struct device* dev) {
+    return dev != nullptr;
+}
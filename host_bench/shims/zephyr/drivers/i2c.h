@@ -0,0 +1,30 @@
+/**
+ * @file i2c.h
+ * @brief Host shim of the Zephyr I2C API
+ *
+ * Only the write-read transaction exists. It is served by the simulated
+ * SHT3x in host_shims.cpp, which answers measurement commands with a
+ * CRC-protected frame like the real sensor.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <zephyr/device.h>
+
+struct i2c_dt_spec {
+    const struct device* bus;  ///< I2C controller
+    uint16_t addr;             ///< Target address
+};
+
+/// I2C controller of the simulated SHT3x
+extern const struct device shim_device_i2c;
+
+inline bool i2c_is_ready_dt(const struct i2c_dt_spec* spec) {
+    return device_is_ready(spec->bus);
+}
+
+int i2c_write_read_dt(const struct i2c_dt_spec* spec, const void* write_buf, size_t num_write,
+                      void* read_buf, size_t num_read);
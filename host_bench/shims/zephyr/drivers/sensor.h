@@ -0,0 +1,38 @@
+/**
+ * @file sensor.h
+ * @brief Host shim of the Zephyr sensor API
+ *
+ * The value conversions are the ones of the Zephyr headers, so their cost
+ * is measured as in the firmware. sensor_sample_fetch() and
+ * sensor_channel_get() are served by the simulated SHT3x in host_shims.cpp.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <zephyr/device.h>
+
+struct sensor_value {
+    int32_t val1;  ///< Integer part
+    int32_t val2;  ///< Fractional part in millionths
+};
+
+enum sensor_channel {
+    SENSOR_CHAN_AMBIENT_TEMP,
+    SENSOR_CHAN_HUMIDITY,
+    SENSOR_CHAN_ALL,
+};
+
+inline double sensor_value_to_double(const struct sensor_value* val) {
+    return (double)val->val1 + (double)val->val2 / 1000000;
+}
+
+inline int64_t sensor_value_to_milli(const struct sensor_value* val) {
+    return ((int64_t)val->val1 * 1000) + val->val2 / 1000;
+}
+
+int sensor_sample_fetch(const struct device* dev);
+
+int sensor_channel_get(const struct device* dev, enum sensor_channel chan,
+                       struct sensor_value* val);
@@ -0,0 +1,92 @@
+/**
+ * @file kernel.h
+ * @brief Host shim of the Zephyr kernel API used by the application modules
+ *
+ * Time is taken from std::chrono::steady_clock: the uptime starts at the
+ * first call, one tick is one microsecond and one cycle is one nanosecond.
+ * Spinlocks are real spinlocks, so the modules stay race-free under
+ * ThreadSanitizer.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#define CONFIG_SYS_CLOCK_TICKS_PER_SEC 1000000
+
+#define MSEC_PER_SEC 1000
+#define USEC_PER_MSEC 1000
+#define USEC_PER_SEC 1000000
+#define NSEC_PER_USEC 1000
+#define NSEC_PER_MSEC 1000000
+
+#define ARG_UNUSED(x) (void)(x)
+
+/// Relative timeout in ms; negative waits forever
+typedef struct {
+    int64_t ms;
+} k_timeout_t;
+
+#define K_NO_WAIT (k_timeout_t{0})
+#define K_FOREVER (k_timeout_t{-1})
+#define K_MSEC(ms) (k_timeout_t{static_cast<int64_t>(ms)})
+#define K_SECONDS(s) (k_timeout_t{static_cast<int64_t>(s) * MSEC_PER_SEC})
+#define K_TIMEOUT_ABS_MS(t) (k_timeout_t{static_cast<int64_t>(t) - k_uptime_get()})
+
+/// Start of the shim uptime
+inline std::chrono::steady_clock::time_point shim_boot_time() {
+    static const std::chrono::steady_clock::time_point boot = std::chrono::steady_clock::now();
+    return boot;
+}
+
+inline int64_t k_uptime_ticks() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 shim_boot_time())
+        .count();
+}
+
+inline uint64_t k_ticks_to_us_floor64(uint64_t ticks) {
+    return ticks;
+}
+
+inline int64_t k_uptime_get() {
+    return k_uptime_ticks() / USEC_PER_MSEC;
+}
+
+inline uint32_t k_uptime_get_32() {
+    return static_cast<uint32_t>(k_uptime_get());
+}
+
+inline uint32_t k_cycle_get_32() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - shim_boot_time())
+                                     .count());
+}
+
+inline uint64_t k_cyc_to_ns_floor64(uint64_t cycles) {
+    return cycles;
+}
+
+inline uint32_t k_cyc_to_us_floor32(uint32_t cycles) {
+    return cycles / NSEC_PER_USEC;
+}
+
+struct k_spinlock {
+    std::atomic_flag locked = ATOMIC_FLAG_INIT;
+};
+
+typedef int k_spinlock_key_t;
+
+inline k_spinlock_key_t k_spin_lock(struct k_spinlock* lock) {
+    while (lock->locked.test_and_set(std::memory_order_acquire)) {
+    }
+    return 0;
+}
+
+inline void k_spin_unlock(struct k_spinlock* lock, k_spinlock_key_t key) {
+    ARG_UNUSED(key);
+    lock->locked.clear(std::memory_order_release);
+}
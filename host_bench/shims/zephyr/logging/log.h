@@ -0,0 +1,39 @@
+/**
+ * @file log.h
+ * @brief Host shim of the Zephyr logging API
+ *
+ * Messages up to shim_log_level (default: warnings) are printed to stderr,
+ * the arguments are always format-checked like in the firmware build.
+ */
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+#define LOG_LEVEL_ERR 1
+#define LOG_LEVEL_WRN 2
+#define LOG_LEVEL_INF 3
+#define LOG_LEVEL_DBG 4
+
+/// Highest level that is printed
+inline int shim_log_level = LOG_LEVEL_WRN;
+
+__attribute__((format(printf, 2, 3))) inline void shim_log(int level, const char* fmt, ...) {
+    if (level > shim_log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    std::vfprintf(stderr, fmt, args);
+    va_end(args);
+    std::fputc('\n', stderr);
+}
+
+#define LOG_MODULE_REGISTER(name, ...) static_assert(true, #name)
+#define LOG_MODULE_DECLARE(name, ...) static_assert(true, #name)
+
+#define LOG_ERR(...) shim_log(LOG_LEVEL_ERR, __VA_ARGS__)
+#define LOG_WRN(...) shim_log(LOG_LEVEL_WRN, __VA_ARGS__)
+#define LOG_INF(...) shim_log(LOG_LEVEL_INF, __VA_ARGS__)
+#define LOG_DBG(...) shim_log(LOG_LEVEL_DBG, __VA_ARGS__)
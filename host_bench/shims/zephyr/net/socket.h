@@ -0,0 +1,28 @@
+/**
+ * @file socket.h
+ * @brief Host shim of the Zephyr socket API
+ *
+ * Addresses and constants come from the Linux headers. The zsock_*()
+ * calls go to the mock socket of host_shims.cpp, which never touches the
+ * network, so the send path can be measured without kernel overhead.
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <cstddef>
+
+#define ZSOCK_MSG_DONTWAIT MSG_DONTWAIT
+
+int zsock_socket(int family, int type, int proto);
+int zsock_close(int sock);
+int zsock_connect(int sock, const struct sockaddr* addr, socklen_t addrlen);
+ssize_t zsock_send(int sock, const void* buf, size_t len, int flags);
+
+inline int zsock_inet_pton(int family, const char* src, void* dst) {
+    return inet_pton(family, src, dst);
+}
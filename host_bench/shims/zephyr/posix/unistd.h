@@ -0,0 +1,8 @@
+/**
+ * @file unistd.h
+ * @brief Host shim: the Linux header serves the firmware include path
+ */
+
+#pragma once
+
+#include <unistd.h>
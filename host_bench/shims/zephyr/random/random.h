@@ -0,0 +1,14 @@
+/**
+ * @file random.h
+ * @brief Host shim of the Zephyr random number API
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+inline uint32_t sys_rand32_get() {
+    static std::random_device entropy;
+    return entropy();
+}
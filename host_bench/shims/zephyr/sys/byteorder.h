@@ -0,0 +1,17 @@
+/**
+ * @file byteorder.h
+ * @brief Host shim of the Zephyr byte order helpers
+ */
+
+#pragma once
+
+#include <cstdint>
+
+inline void sys_put_be16(uint16_t val, uint8_t dst[2]) {
+    dst[0] = static_cast<uint8_t>(val >> 8);
+    dst[1] = static_cast<uint8_t>(val);
+}
+
+inline uint16_t sys_get_be16(const uint8_t src[2]) {
+    return static_cast<uint16_t>((src[0] << 8) | src[1]);
+}
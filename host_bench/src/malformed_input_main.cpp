@@ -0,0 +1,221 @@
+/**
+ * @file malformed_input_main.cpp
+ * @brief Decoder robustness against crafted and corrupted datagrams
+ *
+ * The host receiver decodes datagrams straight from the network, so
+ * SensorProtocol::decode() and SampleCodec::decode() must reject any
+ * malformed input without undefined behavior. This program feeds them
+ * hand-crafted payloads (arithmetic overflow in the predictors, values out
+ * of range, truncated and overlong varints) and randomly corrupted valid
+ * datagrams. Built with -DHOST_BENCH_SANITIZE=address,undefined, any
+ * overflow or out-of-bounds access aborts the run.
+ *
+ * Usage:
+ *   sensor_malformed_input [--iterations 200000]
+ *
+ * Exits with 1 if a crafted payload is accepted or a corrupted datagram
+ * decodes to an invalid sample.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "sample_codec.h"
+#include "sensor_protocol.h"
+
+namespace {
+
+/// Command line options
+struct Options {
+    unsigned iterations = 200000;  ///< Corrupted datagrams per encoding
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr, "Usage: %s [--iterations N]\n", prog);
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--iterations") == 0 && has_value) {
+            opt.iterations = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Builds a SampleCodec payload from raw varint codes
+class Payload {
+public:
+    /// Append one varint
+    Payload& varint(uint64_t v) {
+        while (v >= 0x80) {
+            bytes_.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        bytes_.push_back(static_cast<uint8_t>(v));
+        return *this;
+    }
+
+    /// Append one sample: sensor, sequence gap, timestamp, temperature and humidity codes
+    Payload& sample(uint64_t sensor, uint64_t seq, uint64_t ts, uint64_t temp, uint64_t hum) {
+        return varint(sensor).varint(seq).varint(ts).varint(temp).varint(hum);
+    }
+
+    /// Append raw bytes
+    Payload& raw(std::initializer_list<uint8_t> bytes) {
+        bytes_.insert(bytes_.end(), bytes);
+        return *this;
+    }
+
+    const std::vector<uint8_t>& bytes() const {
+        return bytes_;
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+};
+
+/// One hand-crafted payload that must be rejected
+struct Crafted {
+    const char* name;      ///< Case name
+    uint64_t base;         ///< Datagram base timestamp
+    size_t count;          ///< Samples announced in the header
+    Payload payload;       ///< Compressed payload
+};
+
+const uint64_t kMaxCode = UINT64_MAX;                             ///< zigzag(INT64_MIN)
+const uint64_t kMaxPositive = SampleCodec::zigzag(INT64_MAX);  ///< Largest positive code
+
+std::vector<Crafted> craftedCases() {
+    std::vector<Crafted> cases;
+    cases.push_back({"first timestamp overflows base", 0x7FFFFFFFFFFFFFF0ull, 1,
+                     Payload().sample(0, 0, kMaxPositive, 0, 0)});
+    cases.push_back({"timestamp delta overflows", 0, 3,
+                     Payload()
+                         .sample(0, 0, 0, 0, 0)
+                         .sample(0, 0, kMaxPositive, 0, 0)
+                         .sample(0, 0, SampleCodec::zigzag(1), 0, 0)});
+    cases.push_back({"timestamp below zero", 0, 2,
+                     Payload().sample(0, 0, 0, 0, 0).sample(0, 0, kMaxCode, 0, 0)});
+    cases.push_back({"temperature code overflows", 0, 2,
+                     Payload().sample(0, 0, 0, kMaxPositive, 0).sample(0, 0, 0, kMaxPositive, 0)});
+    cases.push_back({"humidity code overflows", 0, 1,
+                     Payload().sample(0, 0, 0, 0, kMaxCode)});
+    cases.push_back({"temperature out of range", 0, 2,
+                     Payload()
+                         .sample(0, 0, 0, SampleCodec::zigzag(INT16_MAX), 0)
+                         .sample(0, 0, 0, SampleCodec::zigzag(1), 0)});
+    cases.push_back({"humidity below zero", 0, 1,
+                     Payload().sample(0, 0, 0, 0, SampleCodec::zigzag(-1))});
+    cases.push_back({"sensor index out of range", 0, 1,
+                     Payload().sample(SensorProtocol::kMaxSensors, 0, 0, 0, 0)});
+    cases.push_back({"truncated varint", 0, 1, Payload().varint(0).varint(0).raw({0x80})});
+    cases.push_back({"overlong varint", 0, 1,
+                     Payload().varint(0).varint(0).raw(
+                         {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01})});
+    cases.push_back({"trailing bytes", 0, 1, Payload().sample(0, 0, 0, 0, 0).raw({0x00})});
+    return cases;
+}
+
+/// Run the crafted cases, return the number of accepted ones
+unsigned runCrafted() {
+    unsigned failures = 0;
+    WireSample samples[8];
+    for (const auto& c : craftedCases()) {
+        const bool accepted = SampleCodec::decode(c.payload.bytes().data(),
+                                                  c.payload.bytes().size(), c.base, 0, samples,
+                                                  c.count);
+        std::printf("%-36s %s\n", c.name, accepted ? "ACCEPTED" : "rejected");
+        if (accepted) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/// Encode a valid datagram of a few sensors as a starting point for corruption
+size_t validDatagram(bool compressed, uint8_t* out, size_t capacity) {
+    WireSample samples[32];
+    for (size_t i = 0; i < 32; ++i) {
+        samples[i].sensor = static_cast<uint8_t>(i % 3);
+        samples[i].sequence = 1000 + static_cast<uint32_t>(i);
+        samples[i].timestamp_us = 5000000 + i * 333333 + (i * 7) % 40;
+        samples[i].temperature = static_cast<int16_t>(2150 + (i * 13) % 50 - 25);
+        samples[i].humidity = static_cast<uint16_t>(4500 + (i * 29) % 80);
+    }
+    WirePacketHeader header = {};
+    header.device_id = 7;
+    header.sequence = 42;
+    return compressed ? SensorProtocol::encodeCompressed(header, samples, 32, out, capacity)
+                      : SensorProtocol::encode(header, samples, 32, out, capacity);
+}
+
+/// Decode randomly corrupted datagrams, return the number of invalid results
+unsigned runCorrupted(bool compressed, unsigned iterations) {
+    uint8_t valid[1500];
+    const size_t len = validDatagram(compressed, valid, sizeof(valid));
+    if (len == 0) {
+        std::printf("%s: encoding failed\n", compressed ? "compressed" : "plain");
+        return 1;
+    }
+
+    std::mt19937 rng(compressed ? 2 : 1);
+    std::vector<WireSample> samples(SensorProtocol::kMaxSamples);
+    unsigned accepted = 0;
+    unsigned failures = 0;
+    uint8_t data[1500];
+
+    for (unsigned i = 0; i < iterations; ++i) {
+        std::memcpy(data, valid, len);
+        size_t n = len;
+        // Flip a few bytes past the magic and version, sometimes truncate
+        const unsigned flips = 1 + rng() % 4;
+        for (unsigned f = 0; f < flips; ++f) {
+            data[3 + rng() % (n - 3)] = static_cast<uint8_t>(rng());
+        }
+        if (rng() % 8 == 0) {
+            n = SensorProtocol::kHeaderSize + rng() % (n - SensorProtocol::kHeaderSize);
+        }
+
+        WirePacketHeader header;
+        if (!SensorProtocol::decode(data, n, header, samples.data(), samples.size())) {
+            continue;
+        }
+        accepted++;
+        for (size_t s = 0; s < header.count; ++s) {
+            if (samples[s].sensor >= SensorProtocol::kMaxSensors) {
+                failures++;
+                break;
+            }
+        }
+    }
+    std::printf("%-36s %u of %u corrupted datagrams decoded, %u invalid\n",
+                compressed ? "corrupted compressed datagrams" : "corrupted plain datagrams",
+                accepted, iterations, failures);
+    return failures;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    unsigned failures = runCrafted();
+    failures += runCorrupted(false, opt.iterations);
+    failures += runCorrupted(true, opt.iterations);
+
+    std::printf("%s\n", failures == 0 ? "All malformed inputs handled" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
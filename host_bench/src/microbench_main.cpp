@@ -0,0 +1,297 @@
+/**
+ * @file microbench_main.cpp
+ * @brief Per-sample cost of the firmware hot paths on the host
+ *
+ * Runs the application modules against the simulated SHT3x and the mock
+ * socket of the shims and reports the time per sample (or datagram) in
+ * nanoseconds for every stage of the pipeline: sensor value conversion,
+ * the sensor API and the direct I2C read path, SensorData to wire format, encoding and decoding, the deadband check
+ * and the send path through UdpClient and BatchingSender.
+ *
+ * Every case is repeated with a doubling iteration count until it ran for
+ * at least --min-time milliseconds. The numbers are host numbers: they
+ * rank the stages and catch regressions, the absolute cost on the
+ * Cortex-M7 is several times higher.
+ *
+ * Usage:
+ *   sensor_microbench [--min-time 300] [--filter NAME] [--verbose]
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "batching_sender.h"
+#include "device_clock.h"
+#include "host_shims.h"
+#include "sensor_handler.h"
+#include "sensor_protocol.h"
+#include "sht3xd_direct_reader.h"
+#include "transmit_policy.h"
+#include "udp_client.h"
+
+namespace {
+
+/// Command line options
+struct Options {
+    unsigned min_time_ms = 300;    ///< Minimum measured run time per case
+    const char* filter = nullptr;  ///< Only run cases whose name contains this
+    bool verbose = false;          ///< Print the module logs up to LOG_INF
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr, "Usage: %s [--min-time MS] [--filter NAME] [--verbose]\n", prog);
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--min-time") == 0 && has_value) {
+            opt.min_time_ms = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--filter") == 0 && has_value) {
+            opt.filter = argv[++i];
+        } else if (std::strcmp(arg, "--verbose") == 0) {
+            opt.verbose = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.min_time_ms > 0;
+}
+
+/// Keep the compiler from optimizing a result away
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief One measured operation
+ */
+struct Case {
+    const char* name;           ///< Case name, matched by --filter
+    const char* unit;           ///< What one unit of work is
+    size_t units;               ///< Units of work per call of run
+    std::function<void()> run;  ///< The measured operation
+};
+
+/**
+ * @brief Time a case until it ran for at least min_time_ms
+ *
+ * @return Nanoseconds per unit of work
+ */
+double measure(const Case& c, unsigned min_time_ms, uint64_t& iterations) {
+    using Clock = std::chrono::steady_clock;
+    const auto min_time = std::chrono::milliseconds(min_time_ms);
+
+    // Warm-up: caches, branch predictors, lazily initialized state
+    for (int i = 0; i < 1000; ++i) {
+        c.run();
+    }
+
+    iterations = 1000;
+    while (true) {
+        const auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            c.run();
+        }
+        const auto elapsed = Clock::now() - start;
+        if (elapsed >= min_time) {
+            const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+            return ns / static_cast<double>(iterations * c.units);
+        }
+        iterations *= 2;
+    }
+}
+
+/**
+ * @brief Fill a batch with a steady 50 Hz series of one sensor
+ *
+ * Timestamps jitter by a few microseconds like the scheduler's, so the
+ * compressed size matches what the firmware sends.
+ */
+void synthesize(WireSample* samples, size_t count) {
+    uint32_t state = 1;
+    int16_t temperature = 2350;
+    uint16_t humidity = 4500;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1103515245u + 12345u;
+        temperature = static_cast<int16_t>(temperature + static_cast<int>((state >> 16) % 3) - 1);
+        humidity = static_cast<uint16_t>(humidity + static_cast<int>((state >> 20) % 5) - 2);
+        samples[i].temperature = temperature;
+        samples[i].humidity = humidity;
+        samples[i].timestamp_us = 1000000 + i * 20000 + (state >> 24) % 8;
+        samples[i].sequence = static_cast<uint32_t>(100 + i);
+        samples[i].sensor = 0;
+    }
+}
+
+/**
+ * @brief Check that the codec reproduces the synthetic batch
+ *
+ * Cheap guard against benchmarking a broken build (e.g. under sanitizers).
+ */
+bool selfTest(const WireSample* samples, size_t count) {
+    WirePacketHeader header{};
+    header.device_id = 1;
+    uint8_t buf[SensorProtocol::encodedSize(SensorProtocol::kMaxSamples)];
+    const size_t len = SensorProtocol::encodeCompressed(header, samples, count, buf, sizeof(buf));
+
+    WireSample decoded[SensorProtocol::kMaxSamples];
+    if (len == 0 || !SensorProtocol::decode(buf, len, header, decoded, count)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (decoded[i].temperature != samples[i].temperature ||
+            decoded[i].humidity != samples[i].humidity ||
+            decoded[i].timestamp_us != samples[i].timestamp_us ||
+            decoded[i].sequence != samples[i].sequence) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+    const int log_level = opt.verbose ? LOG_LEVEL_INF : LOG_LEVEL_WRN;
+    shim_log_level = log_level;
+
+    DeviceClock::init();
+
+    constexpr size_t kBatch = CONFIG_APP_UDP_BATCH_SIZE;
+    WireSample batch[kBatch];
+    synthesize(batch, kBatch);
+    if (!selfTest(batch, kBatch)) {
+        std::fprintf(stderr, "Codec self-test failed\n");
+        return 1;
+    }
+
+    // Fixtures shared by the cases
+    struct sensor_value raw_temperature;
+    struct sensor_value raw_humidity;
+    sensor_sample_fetch(DEVICE_DT_GET_ONE(sensirion_sht3xd));
+    sensor_channel_get(DEVICE_DT_GET_ONE(sensirion_sht3xd), SENSOR_CHAN_AMBIENT_TEMP,
+                       &raw_temperature);
+    sensor_channel_get(DEVICE_DT_GET_ONE(sensirion_sht3xd), SENSOR_CHAN_HUMIDITY,
+                       &raw_humidity);
+
+    SHT3xReader reader;
+    SHT3xDirectReader direct({&shim_device_i2c, 0x44});
+    SensorHandler handler;
+    handler.update();
+    const SensorData sample = handler.getData();
+
+    WirePacketHeader header{};
+    header.device_id = CONFIG_APP_DEVICE_ID;
+    static uint8_t plain[SensorProtocol::encodedSize(kBatch)];
+    static uint8_t compressed[SensorProtocol::encodedSize(kBatch)];
+    const size_t plain_len = SensorProtocol::encode(header, batch, kBatch, plain, sizeof(plain));
+    const size_t compressed_len =
+        SensorProtocol::encodeCompressed(header, batch, kBatch, compressed, sizeof(compressed));
+    WireSample decoded[kBatch];
+
+    DeadbandPolicy deadband(10, 50, 60000);
+    SensorData walking = sample;
+
+    UdpClient client("127.0.0.1", 8888);
+    BatchingSender sender(client);
+
+    const std::vector<Case> cases = {
+        {"sensor_value_to_double", "sample", 1,
+         [&] {
+             keep(sensor_value_to_double(&raw_temperature));
+             keep(sensor_value_to_double(&raw_humidity));
+         }},
+        {"sht3x_fetch", "sample", 1,
+         [&] {
+             keep(reader.fetch());
+             keep(reader.getTemperature());
+         }},
+        {"sht3x_direct_fetch", "sample", 1,
+         [&] {
+             keep(direct.fetch());
+             keep(direct.getTemperatureCenti());
+         }},
+        {"sensor_handler_update", "sample", 1,
+         [&] {
+             keep(handler.update());
+             keep(handler.getData());
+         }},
+        {"to_fixed_point", "sample", 1,
+         [&] {
+             keep(SensorProtocol::toCentiCelsius(sample.temperature));
+             keep(SensorProtocol::toCentiPercent(sample.humidity));
+         }},
+        {"deadband_admit", "sample", 1,
+         [&] {
+             walking.temperature += 0.01f;
+             walking.timestamp_us += 20000;
+             keep(deadband.admit(walking));
+         }},
+        {"encode_plain", "sample", kBatch,
+         [&] { keep(SensorProtocol::encode(header, batch, kBatch, plain, sizeof(plain))); }},
+        {"encode_compressed", "sample", kBatch,
+         [&] {
+             keep(SensorProtocol::encodeCompressed(header, batch, kBatch, compressed,
+                                                   sizeof(compressed)));
+         }},
+        {"decode_plain", "sample", kBatch,
+         [&] {
+             WirePacketHeader h;
+             keep(SensorProtocol::decode(plain, plain_len, h, decoded, kBatch));
+         }},
+        {"decode_compressed", "sample", kBatch,
+         [&] {
+             WirePacketHeader h;
+             keep(SensorProtocol::decode(compressed, compressed_len, h, decoded, kBatch));
+         }},
+        {"udp_client_send", "datagram", 1,
+         [&] { keep(client.send(compressed, compressed_len)); }},
+        {"batching_sender_add", "sample", 1, [&] { keep(sender.add(sample)); }},
+        {"batching_sender_refused", "sample", 1,
+         [&] {
+             // Every second datagram refused: the back-pressure drop path
+             HostShims::socket().refuse_every = 2;
+             keep(sender.add(sample));
+             HostShims::socket().refuse_every = 0;
+         }},
+    };
+
+    std::printf("Encoded batch of %zu samples: %zu bytes plain, %zu bytes compressed\n\n", kBatch,
+                plain_len, compressed_len);
+    std::printf("%-26s %-9s %12s %10s\n", "case", "unit", "iterations", "ns/unit");
+
+    for (const Case& c : cases) {
+        if (opt.filter != nullptr && std::strstr(c.name, opt.filter) == nullptr) {
+            continue;
+        }
+        // The refused case makes BatchingSender warn about drops
+        const bool refusing = std::strcmp(c.name, "batching_sender_refused") == 0;
+        shim_log_level = refusing && !opt.verbose ? LOG_LEVEL_ERR : log_level;
+        uint64_t iterations = 0;
+        const double ns = measure(c, opt.min_time_ms, iterations);
+        std::printf("%-26s %-9s %12llu %10.1f\n", c.name, c.unit,
+                    static_cast<unsigned long long>(iterations), ns);
+    }
+
+    const HostShims::MockSocket& socket = HostShims::socket();
+    std::printf("\nMock socket: %llu datagrams, %llu bytes, %llu refused\n",
+                static_cast<unsigned long long>(socket.sent),
+                static_cast<unsigned long long>(socket.bytes),
+                static_cast<unsigned long long>(socket.refused));
+    return 0;
+}
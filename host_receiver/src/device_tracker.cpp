@@ -0,0 +1,236 @@
+/**
+ * @file device_tracker.cpp
+ * @brief Implementation of per-device loss, reordering and latency tracking
+ */
+
+#include "device_tracker.h"
+
+#include <cstring>
+
+/**
+ * @brief Start the window for a boot with its first received sequence number
+ */
+void SequenceWindow::reset(uint32_t boot_id, uint32_t sequence) {
+    boot_id_ = boot_id;
+    highest_ = sequence;
+    std::memset(bits_, 0, sizeof(bits_));
+    bits_[0] = 1;
+}
+
+/**
+ * @brief Mark a sequence number as received
+ *
+ * Serial-number arithmetic handles the 32-bit wrap-around. A newer number
+ * shifts the window; bits that fall out of it are forgotten.
+ */
+bool SequenceWindow::insert(uint32_t sequence) {
+    const int32_t diff = static_cast<int32_t>(sequence - highest_);
+    if (diff > 0) {
+        const uint32_t shift = static_cast<uint32_t>(diff);
+        if (shift >= kSize) {
+            std::memset(bits_, 0, sizeof(bits_));
+        } else {
+            // Shift the bitmap by whole words, then by the remaining bits
+            const uint32_t words = shift / 64;
+            const uint32_t bits = shift % 64;
+            constexpr uint32_t kWords = kSize / 64;
+            for (uint32_t i = kWords; i-- > 0;) {
+                uint64_t value = i >= words ? bits_[i - words] << bits : 0;
+                if (bits != 0 && i > words) {
+                    value |= bits_[i - words - 1] >> (64 - bits);
+                }
+                bits_[i] = value;
+            }
+        }
+        highest_ = sequence;
+        bits_[0] |= 1;
+        return true;
+    }
+
+    const uint32_t offset = static_cast<uint32_t>(-static_cast<int64_t>(diff));
+    if (offset >= kSize) {
+        return true;
+    }
+    uint64_t& word = bits_[offset / 64];
+    const uint64_t mask = uint64_t{1} << (offset % 64);
+    if ((word & mask) != 0) {
+        return false;
+    }
+    word |= mask;
+    return true;
+}
+
+/**
+ * @brief Account one decoded datagram
+ *
+ * The sample sequence is followed on the latest datagrams only; a jump
+ * counts the skipped samples as gaps. Samples of a late datagram were
+ * counted as gaps when the jump happened and are subtracted again. Gaps
+ * that remain were dropped on the device (sample ring overflow, deadband
+ * suppression) or lost with their datagram. A datagram received before
+ * only counts as duplicate.
+ */
+bool DeviceTracker::update(const WirePacketHeader& header, const WireSample* samples,
+                           std::chrono::steady_clock::time_point now, int64_t ingest_unix_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto inserted = devices_.try_emplace(header.device_id);
+    DeviceState& state = inserted.first->second.state;
+
+    const Order order = account(inserted.first->second, inserted.second, header, now);
+    if (order == Order::kDuplicate) {
+        return false;
+    }
+    state.samples += header.count;
+
+    if (order == Order::kLatest) {
+        for (size_t i = 0; i < header.count; ++i) {
+            const int32_t diff = static_cast<int32_t>(samples[i].sequence - state.sample_sequence);
+            if (!state.has_sample || diff > 0) {
+                if (state.has_sample) {
+                    state.gaps += static_cast<uint32_t>(diff - 1);
+                }
+                state.sample_sequence = samples[i].sequence;
+                state.has_sample = true;
+            }
+        }
+        if (header.count > 0) {
+            state.last_temperature = samples[header.count - 1].temperature;
+            state.last_humidity = samples[header.count - 1].humidity;
+        }
+    } else if (order == Order::kLate) {
+        state.gaps -= header.count < state.gaps ? header.count : state.gaps;
+    }
+
+    // Replayed datagrams are late by design, their latency says nothing about the path
+    if ((header.flags & kFlagClockSynced) != 0 && (header.flags & kFlagBackfill) == 0) {
+        for (size_t i = 0; i < header.count; ++i) {
+            const int64_t captured =
+                static_cast<int64_t>(samples[i].timestamp_us) + header.clock_offset;
+            const int64_t latency = ingest_unix_us - captured;
+            state.latency_sum_us += latency;
+            if (state.latency_count == 0 || latency > state.latency_max_us) {
+                state.latency_max_us = latency;
+            }
+            state.latency_count++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Account one decoded datagram of window summaries
+ */
+void DeviceTracker::update(const WirePacketHeader& header, const WireAggregate* aggregates,
+                           std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto inserted = devices_.try_emplace(header.device_id);
+    DeviceState& state = inserted.first->second.state;
+
+    const Order order = account(inserted.first->second, inserted.second, header, now);
+    if (order == Order::kDuplicate) {
+        return;
+    }
+    state.aggregates += header.count;
+    for (size_t i = 0; i < header.count; ++i) {
+        state.samples += aggregates[i].count;
+    }
+    if (order == Order::kLatest && header.count > 0) {
+        state.last_temperature = aggregates[header.count - 1].temperature_mean;
+        state.last_humidity = aggregates[header.count - 1].humidity_mean;
+    }
+}
+
+/**
+ * @brief Sequence bookkeeping shared by both datagram types
+ *
+ * Sequence numbers are compared with serial-number arithmetic so that the
+ * 32-bit wrap-around is handled. A gap counts the missing datagrams as
+ * lost; a late datagram that fills such a gap is counted as reordered and
+ * no longer as lost. A new boot ID is a device restart and starts a new
+ * sequence. Datagrams with kFlagBackfill were stored by the device during
+ * an outage and arrive late by design: they only reduce the loss counter,
+ * and those of an earlier boot do not touch the sequence at all.
+ *
+ * Every boot keeps a SequenceWindow, so a datagram received before - a
+ * network duplicate, or a flash page replayed again after a reboot - is
+ * kDuplicate wherever it falls in the sequence and reduces no counter.
+ *
+ * @return Position of the datagram in the sequence of the device
+ */
+DeviceTracker::Order DeviceTracker::account(Device& device, bool inserted,
+                                            const WirePacketHeader& header,
+                                            std::chrono::steady_clock::time_point now) {
+    DeviceState& state = device.state;
+    Order order = Order::kLatest;
+    const bool backfill = (header.flags & kFlagBackfill) != 0;
+
+    if (inserted) {
+        state.first_seen = now;
+        state.boot_id = header.boot_id;
+        state.last_sequence = header.sequence;
+        device.current.reset(header.boot_id, header.sequence);
+    } else if (header.boot_id != state.boot_id) {
+        if (backfill) {
+            bool created = false;
+            SequenceWindow& window = pastWindow(device, header.boot_id, header.sequence, created);
+            order = created || window.insert(header.sequence) ? Order::kOtherBoot
+                                                              : Order::kDuplicate;
+        } else {
+            state.restarts++;
+            state.boot_id = header.boot_id;
+            state.last_sequence = header.sequence;
+            state.has_sample = false;
+            device.past[device.past_next] = device.current;
+            device.past_next = (device.past_next + 1) % kPastBoots;
+            device.current.reset(header.boot_id, header.sequence);
+        }
+    } else {
+        const int32_t diff = static_cast<int32_t>(header.sequence - state.last_sequence);
+        if (!device.current.insert(header.sequence)) {
+            order = Order::kDuplicate;
+        } else if (diff > 0) {
+            state.lost += static_cast<uint32_t>(diff - 1);
+            state.last_sequence = header.sequence;
+        } else {
+            // A replayed datagram fills a gap; it is not reordering
+            order = Order::kLate;
+            if (!backfill) {
+                state.reordered++;
+            }
+            if (state.lost > 0) {
+                state.lost--;
+            }
+        }
+    }
+
+    if (order == Order::kDuplicate) {
+        state.duplicates++;
+    } else if (backfill) {
+        state.backfilled++;
+    }
+    state.datagrams++;
+    state.last_seen = now;
+    return order;
+}
+
+/**
+ * @brief Window of an earlier boot, taking over the oldest slot if it is new
+ *
+ * @param created Set to true if the window was started with @p sequence
+ */
+SequenceWindow& DeviceTracker::pastWindow(Device& device, uint32_t boot_id, uint32_t sequence,
+                                          bool& created) {
+    for (auto& window : device.past) {
+        if (window.bootId() == boot_id) {
+            created = false;
+            return window;
+        }
+    }
+    SequenceWindow& window = device.past[device.past_next];
+    device.past_next = (device.past_next + 1) % kPastBoots;
+    window.reset(boot_id, sequence);
+    created = true;
+    return window;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file device_tracker.h
+ * @brief Per-device reception state for the host-side receiver
+ *
+ * This header provides the bookkeeping the collector keeps for every
+ * sending board: last datagram and sample sequence numbers, loss and
+ * reordering counters, arrival rate and capture-to-ingest latency.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "sensor_protocol.h"
+
+/**
+ * @brief Reception state of one device
+ */
+struct DeviceState {
+    uint32_t boot_id = 0;         ///< Boot ID of the latest datagram
+    uint32_t last_sequence = 0;   ///< Highest datagram sequence number seen
+    uint32_t sample_sequence = 0; ///< Sample sequence number of the latest sample
+    bool has_sample = false;      ///< sample_sequence is valid for the current boot
+    uint64_t datagrams = 0;       ///< Datagrams received
+    uint64_t samples = 0;         ///< Samples received (including those summarized)
+    uint64_t aggregates = 0;      ///< Window summaries received
+    uint64_t lost = 0;            ///< Datagrams missing from the sequence
+    uint64_t reordered = 0;       ///< Datagrams arriving after a later one
+    uint64_t duplicates = 0;      ///< Datagrams whose sequence number was already received
+    uint64_t restarts = 0;        ///< Boot ID changes (device reboot)
+    uint64_t backfilled = 0;      ///< Datagrams replayed from the device's flash store
+    uint64_t gaps = 0;            ///< Samples missing from the sample sequence
+    uint64_t latency_count = 0;   ///< Samples with a capture-to-ingest latency
+    int64_t latency_sum_us = 0;   ///< Sum of the latencies in us
+    int64_t latency_max_us = 0;   ///< Highest latency in us
+    int16_t last_temperature = 0; ///< Latest temperature in 0.01 degrees Celsius
+    uint16_t last_humidity = 0;   ///< Latest humidity in 0.01 %RH
+    std::chrono::steady_clock::time_point first_seen;  ///< Arrival of the first datagram
+    std::chrono::steady_clock::time_point last_seen;   ///< Arrival of the latest datagram
+};
+
+/**
+ * @brief Received datagram sequence numbers of one boot of a device
+ *
+ * A bitmap of the kSize sequence numbers up to the highest one received,
+ * so a repeated datagram is recognized even if later ones arrived in
+ * between. Sequence numbers older than the window cannot be checked and
+ * count as new.
+ */
+class SequenceWindow {
+public:
+    /// Sequence numbers remembered behind the highest one
+    static constexpr uint32_t kSize = 1024;
+
+    /**
+     * @brief Start the window for a boot with its first received sequence number
+     */
+    void reset(uint32_t boot_id, uint32_t sequence);
+
+    /**
+     * @brief Mark a sequence number as received
+     *
+     * @return false if it was already received
+     */
+    bool insert(uint32_t sequence);
+
+    /// Boot the window belongs to
+    uint32_t bootId() const {
+        return boot_id_;
+    }
+
+private:
+    uint32_t boot_id_ = 0;            ///< Boot ID of the window
+    uint32_t highest_ = 0;            ///< Highest sequence number received
+    uint64_t bits_[kSize / 64] = {};  ///< Bit (highest_ - n) set if n was received
+};
+
+/**
+ * @brief Tracks DeviceState for all devices seen by one receive worker
+ *
+ * With SO_REUSEPORT the kernel distributes datagrams by source address, so
+ * one device always lands on the same worker and every worker can keep its
+ * own tracker. The mutex is only contended while a report is taken.
+ *
+ * Usage example:
+ * @code
+ * DeviceTracker tracker;
+ * tracker.update(header, now);
+ *
+ * tracker.forEach([](uint32_t id, const DeviceState& s) { ... });
+ * @endcode
+ */
+class DeviceTracker {
+public:
+    /**
+     * @brief Account one decoded datagram
+     *
+     * The latency of a sample is the ingest time minus its capture time
+     * (timestamp_us + clock_offset); it is only measured for datagrams with
+     * kFlagClockSynced that are not replayed from the store.
+     *
+     * @param header         Decoded datagram header
+     * @param samples        Decoded samples (the last one is kept as latest value)
+     * @param now            Arrival time
+     * @param ingest_unix_us Arrival time in us since the Unix epoch
+     *
+     * @return false if the datagram was already received (its samples are
+     *         already known)
+     */
+    bool update(const WirePacketHeader& header, const WireSample* samples,
+                std::chrono::steady_clock::time_point now, int64_t ingest_unix_us);
+
+    /**
+     * @brief Account one decoded datagram of window summaries
+     *
+     * @param header     Decoded datagram header
+     * @param aggregates Decoded summaries (the mean of the last one is kept as latest value)
+     * @param now        Arrival time
+     */
+    void update(const WirePacketHeader& header, const WireAggregate* aggregates,
+                std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Visit all devices under the tracker lock
+     *
+     * @param fn Callable invoked as fn(device_id, const DeviceState&)
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : devices_) {
+            fn(entry.first, entry.second.state);
+        }
+    }
+
+private:
+    /// Result of the datagram sequence bookkeeping
+    enum class Order {
+        kLatest,     ///< Newest datagram of the current boot
+        kLate,       ///< Older datagram of the current boot filling a gap
+        kDuplicate,  ///< Sequence number already received
+        kOtherBoot,  ///< Backfill from an earlier boot
+    };
+
+    /// Earlier boots whose replayed datagrams are checked for repeats
+    static constexpr size_t kPastBoots = 4;
+
+    /// Reported state plus the duplicate detection of one device
+    struct Device {
+        DeviceState state;                   ///< Counters and latest values
+        SequenceWindow current;              ///< Sequence numbers of the current boot
+        SequenceWindow past[kPastBoots];     ///< Sequence numbers of earlier boots
+        size_t past_next = 0;                ///< Slot in past to reuse next
+    };
+
+    /// Sequence bookkeeping shared by both datagram types
+    Order account(Device& device, bool inserted, const WirePacketHeader& header,
+                  std::chrono::steady_clock::time_point now);
+
+    /// Window of an earlier boot, taking over the oldest slot if it is new
+    SequenceWindow& pastWindow(Device& device, uint32_t boot_id, uint32_t sequence,
+                               bool& created);
+
+    mutable std::mutex mutex_;                     ///< Guards devices_
+    std::unordered_map<uint32_t, Device> devices_; ///< State by device ID
+};
@@ -0,0 +1,251 @@
+/**
+ * @file loadgen_main.cpp
+ * @brief Synthetic sensor datagram generator for receiver load tests
+ *
+ * Emulates many boards without hardware: every sender thread owns a subset
+ * of the simulated devices and its own socket (distinct source port, so
+ * SO_REUSEPORT spreads the load on the receiver side). Datagrams are
+ * encoded with the firmware's SensorProtocol and sent in bursts with
+ * sendmmsg().
+ *
+ * Usage:
+ *   sensor_loadgen [--target 127.0.0.1] [--port 8888] [--threads 1]
+ *                  [--devices 100] [--samples 16] [--rate 0] [--duration 10]
+ *                  [--burst 64] [--compressed]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sensor_protocol.h"
+
+namespace {
+
+/// Command line options
+struct Options {
+    const char* target = "127.0.0.1";  ///< Receiver address
+    uint16_t port = 8888;              ///< Receiver port
+    unsigned threads = 1;              ///< Sender threads
+    unsigned devices = 100;            ///< Simulated devices
+    unsigned samples = 16;             ///< Samples per datagram
+    unsigned rate = 0;                 ///< Datagrams per second in total, 0 = unlimited
+    unsigned duration = 10;            ///< Run time in seconds
+    unsigned burst = 64;               ///< Datagrams per sendmmsg() call
+    bool compressed = false;           ///< Use the compressed payload encoding
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s [--target IP] [--port P] [--threads N] [--devices D]"
+                 " [--samples S] [--rate PKT/S] [--duration S] [--burst B] [--compressed]\n",
+                 prog);
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--target") == 0 && has_value) {
+            opt.target = argv[++i];
+        } else if (std::strcmp(arg, "--port") == 0 && has_value) {
+            opt.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+            opt.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--devices") == 0 && has_value) {
+            opt.devices = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--samples") == 0 && has_value) {
+            opt.samples = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--rate") == 0 && has_value) {
+            opt.rate = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--duration") == 0 && has_value) {
+            opt.duration = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--burst") == 0 && has_value) {
+            opt.burst = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--compressed") == 0) {
+            opt.compressed = true;
+        } else {
+            return false;
+        }
+    }
+    return opt.threads > 0 && opt.devices >= opt.threads && opt.burst > 0 &&
+           opt.samples > 0 && opt.samples <= SensorProtocol::kMaxSamples;
+}
+
+/**
+ * @brief State of one simulated board
+ */
+struct SimDevice {
+    uint32_t id;               ///< Device ID
+    uint32_t boot_id;          ///< Random boot ID of this run
+    uint32_t sequence;         ///< Next datagram sequence number
+    uint32_t sample_sequence;  ///< Next sample sequence number
+    uint64_t timestamp_us;     ///< Next sample timestamp in us
+};
+
+/**
+ * @brief Fill a batch of samples with a slow, noisy indoor climate curve
+ */
+void synthesize(SimDevice& dev, WireSample* samples, unsigned count, std::minstd_rand& rng) {
+    for (unsigned i = 0; i < count; ++i) {
+        const double t = static_cast<double>(dev.timestamp_us) / 1e6;
+        const double noise_t = static_cast<int>(rng() % 5) - 2;
+        const double noise_h = static_cast<int>(rng() % 9) - 4;
+        const double temp = 22.0 + 2.0 * std::sin(t / 600.0 + dev.id) + noise_t * 0.01;
+        const double hum = 45.0 + 5.0 * std::cos(t / 900.0 + dev.id) + noise_h * 0.01;
+        samples[i].temperature = SensorProtocol::toCentiCelsius(static_cast<float>(temp));
+        samples[i].humidity = SensorProtocol::toCentiPercent(static_cast<float>(hum));
+        samples[i].timestamp_us = dev.timestamp_us;
+        samples[i].sequence = dev.sample_sequence++;
+        samples[i].sensor = 0;
+        dev.timestamp_us += 1000000;
+    }
+}
+
+/**
+ * @brief Sender thread: round-robin over its devices, sendmmsg() in bursts
+ *
+ * @param opt       Options
+ * @param index     Thread index, selects the device subset
+ * @param stop      Shared stop flag
+ * @param sent      Receives the number of datagrams sent
+ */
+void sender(const Options& opt, unsigned index, const std::atomic<bool>& stop,
+            std::atomic<uint64_t>& sent) {
+    const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        std::perror("socket");
+        return;
+    }
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(opt.port);
+    if (inet_pton(AF_INET, opt.target, &addr.sin_addr) != 1 ||
+        connect(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::perror("connect");
+        close(sock);
+        return;
+    }
+
+    // A new boot ID per run, so the receiver sees a restarted generator as rebooted devices
+    std::random_device entropy;
+    std::vector<SimDevice> devices;
+    for (unsigned id = index; id < opt.devices; id += opt.threads) {
+        devices.push_back({id + 1, entropy() | 1u, 0, 0, 0});
+    }
+
+    const size_t max_len = SensorProtocol::encodedSize(opt.samples);
+    std::vector<uint8_t> buffers(opt.burst * max_len);
+    std::vector<struct iovec> iovecs(opt.burst);
+    std::vector<struct mmsghdr> msgs(opt.burst);
+    std::vector<WireSample> samples(opt.samples);
+    std::minstd_rand rng(index + 1);
+
+    // Per-thread share of the requested rate, paced per burst
+    const double per_thread_rate = opt.rate > 0 ? static_cast<double>(opt.rate) / opt.threads : 0.0;
+    const auto burst_period = per_thread_rate > 0.0
+                                  ? std::chrono::duration<double>(opt.burst / per_thread_rate)
+                                  : std::chrono::duration<double>(0.0);
+    auto next_burst = std::chrono::steady_clock::now();
+
+    size_t next_device = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (unsigned i = 0; i < opt.burst; ++i) {
+            SimDevice& dev = devices[next_device];
+            next_device = (next_device + 1) % devices.size();
+
+            synthesize(dev, samples.data(), opt.samples, rng);
+
+            WirePacketHeader header{};
+            header.device_id = dev.id;
+            header.boot_id = dev.boot_id;
+            header.sequence = dev.sequence++;
+
+            // Simulated time runs faster than real time; align the clock so that
+            // the newest sample is captured now and the receiver sees the path latency
+            const auto unix_now = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch());
+            header.flags = kFlagClockSynced;
+            header.clock_offset =
+                unix_now.count() - static_cast<int64_t>(samples[opt.samples - 1].timestamp_us);
+
+            uint8_t* out = &buffers[i * max_len];
+            size_t len = 0;
+            if (opt.compressed) {
+                len = SensorProtocol::encodeCompressed(header, samples.data(), opt.samples, out,
+                                                       max_len - 1);
+            }
+            if (len == 0) {
+                len = SensorProtocol::encode(header, samples.data(), opt.samples, out, max_len);
+            }
+
+            iovecs[i].iov_base = out;
+            iovecs[i].iov_len = len;
+            std::memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int n = sendmmsg(sock, msgs.data(), opt.burst, 0);
+        if (n > 0) {
+            sent.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        }
+
+        if (per_thread_rate > 0.0) {
+            next_burst += std::chrono::duration_cast<std::chrono::steady_clock::duration>(burst_period);
+            std::this_thread::sleep_until(next_burst);
+        }
+    }
+
+    close(sock);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::atomic<uint64_t>> sent(opt.threads);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < opt.threads; ++i) {
+        threads.emplace_back(sender, std::cref(opt), i, std::cref(stop), std::ref(sent[i]));
+    }
+
+    std::printf("Sending to %s:%u: %u device(s), %u thread(s), %u samples/datagram%s\n",
+                opt.target, opt.port, opt.devices, opt.threads, opt.samples,
+                opt.compressed ? ", compressed" : "");
+
+    std::this_thread::sleep_for(std::chrono::seconds(opt.duration));
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    uint64_t total = 0;
+    for (auto& count : sent) {
+        total += count.load();
+    }
+    std::printf("Sent %llu datagrams (%llu pkt/s, %llu samples/s)\n",
+                static_cast<unsigned long long>(total),
+                static_cast<unsigned long long>(total / opt.duration),
+                static_cast<unsigned long long>(total * opt.samples / opt.duration));
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file query_main.cpp
+ * @brief Command line queries against a TimeSeriesStore
+ *
+ * Lists the stored series, or prints the samples of one series in a time
+ * range as CSV, either raw or downsampled into min/mean/max buckets. The
+ * store may be queried while sensor_receiver is appending to it. Row
+ * count, bytes scanned and scan throughput go to stderr, so stdout stays
+ * plain CSV.
+ *
+ * Times are Unix seconds (fractions allowed); negative values are relative
+ * to now, e.g. --from -3600 for the last hour.
+ *
+ * Usage:
+ *   sensor_query --store DIR --list
+ *   sensor_query --store DIR --device ID [--sensor 0] [--from T] [--to T]
+ *                [--bucket S]
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "timeseries_store.h"
+
+namespace {
+
+/// Most buckets one query may produce
+constexpr uint64_t kMaxBuckets = 10 * 1000 * 1000;
+
+/// Command line options
+struct Options {
+    const char* store = nullptr;  ///< Store directory
+    bool list = false;            ///< List the series instead of reading one
+    long long device = -1;        ///< Device ID of the series
+    unsigned sensor = 0;          ///< Sensor index of the series
+    const char* from = nullptr;   ///< Start of the range, nullptr = first sample
+    const char* to = nullptr;     ///< End of the range, nullptr = after the last sample
+    double bucket = 0.0;          ///< Bucket length in seconds, 0 = raw samples
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "Usage: %s --store DIR --list\n"
+                 "       %s --store DIR --device ID [--sensor N] [--from T] [--to T]"
+                 " [--bucket S]\n"
+                 "T is in Unix seconds, negative values are relative to now\n",
+                 prog, prog);
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--store") == 0 && has_value) {
+            opt.store = argv[++i];
+        } else if (std::strcmp(arg, "--list") == 0) {
+            opt.list = true;
+        } else if (std::strcmp(arg, "--device") == 0 && has_value) {
+            opt.device = std::atoll(argv[++i]);
+        } else if (std::strcmp(arg, "--sensor") == 0 && has_value) {
+            opt.sensor = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--from") == 0 && has_value) {
+            opt.from = argv[++i];
+        } else if (std::strcmp(arg, "--to") == 0 && has_value) {
+            opt.to = argv[++i];
+        } else if (std::strcmp(arg, "--bucket") == 0 && has_value) {
+            opt.bucket = std::atof(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return opt.store != nullptr && (opt.list || opt.device >= 0) &&
+           opt.sensor < SensorProtocol::kMaxSensors && opt.bucket >= 0.0;
+}
+
+int64_t nowUs() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+/// Convert a --from/--to argument to Unix us
+int64_t parseTime(const char* arg, int64_t now_us) {
+    const double seconds = std::atof(arg);
+    const int64_t us = static_cast<int64_t>(seconds * 1e6);
+    return seconds < 0.0 ? now_us + us : us;
+}
+
+/// Print the index: one line per series
+void printSeries(const TimeSeriesStore& store) {
+    std::printf("device,sensor,rows,chunks,first_us,last_us\n");
+    for (const auto& info : store.series()) {
+        std::printf("%u,%u,%" PRIu64 ",%zu,%" PRId64 ",%" PRId64 "\n", info.key.device,
+                    static_cast<unsigned>(info.key.sensor), info.rows, info.chunks,
+                    info.rows > 0 ? info.first_us : 0, info.rows > 0 ? info.last_us : 0);
+    }
+}
+
+void printStats(const TimeSeriesStore::ScanStats& stats, double seconds) {
+    const double mb = static_cast<double>(stats.bytes) / 1e6;
+    std::fprintf(stderr, "%" PRIu64 " rows from %zu chunk(s), %.1f MB in %.2f ms (%.2f GB/s)\n",
+                 stats.rows, stats.chunks, mb, seconds * 1e3,
+                 seconds > 0.0 ? mb / 1e3 / seconds : 0.0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    TimeSeriesStore store(opt.store);
+    if (!store.open(TimeSeriesStore::Mode::kReadOnly)) {
+        return 1;
+    }
+    if (opt.list) {
+        printSeries(store);
+        return 0;
+    }
+
+    const SeriesKey key{static_cast<uint32_t>(opt.device), static_cast<uint8_t>(opt.sensor)};
+    int64_t first_us = INT64_MAX;
+    int64_t last_us = INT64_MIN;
+    for (const auto& info : store.series()) {
+        if (info.key == key && info.rows > 0) {
+            first_us = info.first_us;
+            last_us = info.last_us;
+        }
+    }
+    if (first_us > last_us) {
+        std::fprintf(stderr, "No samples for device %u sensor %u\n", key.device,
+                     static_cast<unsigned>(key.sensor));
+        return 1;
+    }
+
+    const int64_t now_us = nowUs();
+    const int64_t from_us = opt.from != nullptr ? parseTime(opt.from, now_us) : first_us;
+    const int64_t to_us = opt.to != nullptr ? parseTime(opt.to, now_us) : last_us + 1;
+    if (to_us <= from_us) {
+        std::fprintf(stderr, "Empty time range\n");
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    TimeSeriesStore::ScanStats stats;
+
+    if (opt.bucket > 0.0) {
+        const int64_t bucket_us = static_cast<int64_t>(opt.bucket * 1e6);
+        if (bucket_us <= 0 ||
+            static_cast<uint64_t>(to_us - from_us) / static_cast<uint64_t>(bucket_us) >=
+                kMaxBuckets) {
+            std::fprintf(stderr, "Bucket too short for the time range\n");
+            return 1;
+        }
+        const std::vector<Bucket> buckets =
+            store.downsample(key, from_us, to_us, bucket_us, &stats);
+        const double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("start_us,count,temp_min,temp_mean,temp_max,hum_min,hum_mean,hum_max\n");
+        for (const auto& b : buckets) {
+            if (b.count == 0) {
+                continue;
+            }
+            const double n = static_cast<double>(b.count);
+            std::printf("%" PRId64 ",%" PRIu64 ",%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", b.start_us,
+                        b.count, b.temperature_min / 100.0,
+                        static_cast<double>(b.temperature_sum) / n / 100.0,
+                        b.temperature_max / 100.0, b.humidity_min / 100.0,
+                        static_cast<double>(b.humidity_sum) / n / 100.0, b.humidity_max / 100.0);
+        }
+        printStats(stats, elapsed);
+        return 0;
+    }
+
+    std::printf("timestamp_us,temperature,humidity\n");
+    stats = store.select(key, from_us, to_us, [](int64_t ts, int16_t temp, uint16_t hum) {
+        std::printf("%" PRId64 ",%.2f,%.2f\n", ts, temp / 100.0, hum / 100.0);
+    });
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printStats(stats, elapsed);
+    return 0;
+}
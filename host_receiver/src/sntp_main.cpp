@@ -0,0 +1,149 @@
+/**
+ * @file sntp_main.cpp
+ * @brief Minimal SNTP server for aligning the sensor clocks with the collector
+ *
+ * Answers SNTP client requests (RFC 4330) with the host's CLOCK_REALTIME.
+ * It is a stand-in for a regular NTP daemon on development machines and
+ * for native_sim, where port 123 usually needs root: the firmware and the
+ * receiver then share exactly the same time base, so the latency column
+ * of sensor_receiver only contains the device-to-host path.
+ *
+ * Usage:
+ *   sensor_sntpd [--port 123]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+/// Seconds from the NTP epoch (1900) to the Unix epoch (1970)
+constexpr uint64_t kNtpUnixOffset = 2208988800ULL;
+
+/// Size of an SNTP message without authentication
+constexpr size_t kPacketSize = 48;
+
+/// Offsets of the timestamps in the message
+constexpr size_t kReferenceOffset = 16;
+constexpr size_t kOriginateOffset = 24;
+constexpr size_t kReceiveOffset = 32;
+constexpr size_t kTransmitOffset = 40;
+
+/// Command line options
+struct Options {
+    uint16_t port = 123;  ///< UDP port to listen on
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr, "Usage: %s [--port P]\n", prog);
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--port") == 0 && has_value) {
+            opt.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return opt.port > 0;
+}
+
+/**
+ * @brief Write the current time as 64-bit NTP timestamp (big-endian)
+ */
+void putNow(uint8_t* p) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    const uint32_t seconds = static_cast<uint32_t>(ts.tv_sec + kNtpUnixOffset);
+    const uint32_t fraction =
+        static_cast<uint32_t>((static_cast<uint64_t>(ts.tv_nsec) << 32) / 1000000000ULL);
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uint8_t>(seconds >> (24 - 8 * i));
+        p[4 + i] = static_cast<uint8_t>(fraction >> (24 - 8 * i));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        std::perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(opt.port);
+    if (bind(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::perror("bind");
+        close(sock);
+        return 1;
+    }
+
+    std::printf("SNTP server on UDP port %u (stratum 1, local clock)\n", opt.port);
+
+    uint8_t request[kPacketSize];
+    uint8_t reply[kPacketSize];
+    uint64_t answered = 0;
+    while (true) {
+        struct sockaddr_in peer;
+        socklen_t peer_len = sizeof(peer);
+        const ssize_t n = recvfrom(sock, request, sizeof(request), 0,
+                                   reinterpret_cast<struct sockaddr*>(&peer), &peer_len);
+        if (n < 0) {
+            std::perror("recvfrom");
+            break;
+        }
+
+        // Only client requests (mode 3) are answered
+        if (static_cast<size_t>(n) < kPacketSize || (request[0] & 0x07) != 3) {
+            continue;
+        }
+
+        std::memset(reply, 0, sizeof(reply));
+        putNow(reply + kReceiveOffset);
+
+        const uint8_t version = (request[0] >> 3) & 0x07;
+        reply[0] = static_cast<uint8_t>((version << 3) | 4);  // LI 0, server mode
+        reply[1] = 1;                                         // stratum 1
+        reply[2] = request[2];                                // poll interval
+        reply[3] = static_cast<uint8_t>(-20);                 // precision ~1 us
+        std::memcpy(reply + 12, "LOCL", 4);                   // reference ID
+        std::memcpy(reply + kReferenceOffset, reply + kReceiveOffset, 8);
+        std::memcpy(reply + kOriginateOffset, request + kTransmitOffset, 8);
+        putNow(reply + kTransmitOffset);
+
+        sendto(sock, reply, sizeof(reply), 0, reinterpret_cast<struct sockaddr*>(&peer),
+               peer_len);
+
+        if (answered++ == 0) {
+            char peer_ip[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &peer.sin_addr, peer_ip, sizeof(peer_ip));
+            std::printf("First request answered (%s)\n", peer_ip);
+        }
+    }
+
+    close(sock);
+    return 0;
+}
@@ -0,0 +1,496 @@
+/**
+ * @file timeseries_store.cpp
+ * @brief Implementation of the columnar, memory-mapped sample store
+ */
+
+#include "timeseries_store.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static constexpr char kMagic[4] = {'S', 'H', 'T', 'S'};
+
+/// Suffix of a chunk file while it is being created
+static constexpr char kTempSuffix[] = ".tmp";
+
+/// Path of chunk number seq of a series: <root>/<device>/<sensor>-<seq>.chunk
+static std::string chunk_path(const std::string& root, const SeriesKey& key, size_t seq) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%u-%06zu.chunk", static_cast<unsigned>(key.sensor), seq);
+    return root + "/" + std::to_string(key.device) + name;
+}
+
+/**
+ * @brief Fold a contiguous slice of the columns into one bucket
+ *
+ * Separate loops per column without branches on the data, so that the
+ * compiler turns them into vector min/max/add.
+ */
+static void fold(Bucket& bucket, const int16_t* temperature, const uint16_t* humidity,
+                 size_t n) {
+    int16_t t_min = bucket.temperature_min;
+    int16_t t_max = bucket.temperature_max;
+    int64_t t_sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        t_min = std::min(t_min, temperature[i]);
+        t_max = std::max(t_max, temperature[i]);
+        t_sum += temperature[i];
+    }
+
+    uint16_t h_min = bucket.humidity_min;
+    uint16_t h_max = bucket.humidity_max;
+    int64_t h_sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        h_min = std::min(h_min, humidity[i]);
+        h_max = std::max(h_max, humidity[i]);
+        h_sum += humidity[i];
+    }
+
+    bucket.count += n;
+    bucket.temperature_min = t_min;
+    bucket.temperature_max = t_max;
+    bucket.temperature_sum += t_sum;
+    bucket.humidity_min = h_min;
+    bucket.humidity_max = h_max;
+    bucket.humidity_sum += h_sum;
+}
+
+TimeSeriesStore::Chunk::~Chunk() {
+    if (base_ != nullptr) {
+        munmap(base_, size_);
+    }
+}
+
+/**
+ * @brief Create a new, empty chunk file of the given capacity
+ *
+ * The file is extended to its full size with ftruncate(), which leaves it
+ * sparse: disk blocks are only allocated as the columns fill up. It is
+ * prepared under a temporary name and renamed once the header is written,
+ * so a receiver that dies in between leaves no headerless .chunk behind.
+ */
+bool TimeSeriesStore::Chunk::create(const std::string& path, const SeriesKey& key,
+                                    uint32_t capacity) {
+    const std::string temp = path + kTempSuffix;
+    const int fd = ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::perror(temp.c_str());
+        return false;
+    }
+    size_ = fileSize(capacity);
+    if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        std::perror("ftruncate");
+        ::close(fd);
+        return false;
+    }
+    void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::perror("mmap");
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(base);
+
+    ChunkHeader& h = header();
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = ChunkHeader::kVersion;
+    h.device = key.device;
+    h.sensor = key.sensor;
+    h.capacity = capacity;
+    h.min_us = INT64_MAX;
+    h.max_us = INT64_MIN;
+    h.count.store(0, std::memory_order_release);
+
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::perror(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Map an existing chunk file
+ *
+ * The header is validated against the file size, so a truncated or foreign
+ * file is rejected instead of read past its end.
+ */
+bool TimeSeriesStore::Chunk::map(const std::string& path, bool writable) {
+    const int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        std::perror(path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ChunkHeader)) {
+        std::fprintf(stderr, "%s: not a chunk file\n", path.c_str());
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size_, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::perror("mmap");
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(base);
+
+    const ChunkHeader& h = header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != ChunkHeader::kVersion ||
+        size_ != fileSize(h.capacity) || h.count.load(std::memory_order_acquire) > h.capacity) {
+        std::fprintf(stderr, "%s: invalid chunk header\n", path.c_str());
+        return false;
+    }
+    if (!writable) {
+        // Queries read the columns front to back
+        madvise(base_, size_, MADV_SEQUENTIAL);
+    }
+    return true;
+}
+
+/**
+ * @brief Constructor
+ */
+TimeSeriesStore::TimeSeriesStore(std::string root, uint32_t chunk_capacity)
+    : root_(std::move(root)), chunk_capacity_((chunk_capacity + 63) & ~63u) {
+}
+
+/**
+ * @brief Destructor - close the open chunks and release the lock
+ *
+ * The mappings are shared, so everything appended is already in the page
+ * cache; the kernel writes it back without an explicit msync().
+ */
+TimeSeriesStore::~TimeSeriesStore() {
+    series_.clear();
+    if (lock_fd_ >= 0) {
+        ::close(lock_fd_);
+    }
+}
+
+/**
+ * @brief Open the store and build the index from the chunk headers
+ */
+bool TimeSeriesStore::open(Mode mode) {
+    mode_ = mode;
+    std::error_code ec;
+    if (mode_ == Mode::kReadWrite) {
+        fs::create_directories(root_, ec);
+        if (ec) {
+            std::fprintf(stderr, "%s: %s\n", root_.c_str(), ec.message().c_str());
+            return false;
+        }
+        const std::string lock_path = root_ + "/.lock";
+        lock_fd_ = ::open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (lock_fd_ < 0) {
+            std::perror(lock_path.c_str());
+            return false;
+        }
+        if (flock(lock_fd_, LOCK_EX | LOCK_NB) != 0) {
+            std::fprintf(stderr, "%s: store is already open for writing\n", root_.c_str());
+            return false;
+        }
+    } else if (!fs::is_directory(root_, ec)) {
+        std::fprintf(stderr, "%s: no such store\n", root_.c_str());
+        return false;
+    }
+    return scan();
+}
+
+/**
+ * @brief Index all chunk files below root_
+ *
+ * Reads the header of every chunk; in kReadWrite mode the last chunk of
+ * each series is reopened for appending if it has room left.
+ */
+bool TimeSeriesStore::scan() {
+    std::error_code ec;
+    for (const auto& dir : fs::directory_iterator(root_, ec)) {
+        if (!dir.is_directory()) {
+            continue;
+        }
+        char* end = nullptr;
+        const std::string device_name = dir.path().filename().string();
+        const unsigned long device = std::strtoul(device_name.c_str(), &end, 10);
+        if (end == device_name.c_str() || *end != '\0') {
+            continue;
+        }
+
+        // Chunk names sort by sensor and then by sequence
+        std::vector<fs::path> files;
+        for (const auto& file : fs::directory_iterator(dir.path(), ec)) {
+            if (file.path().extension() == ".chunk") {
+                files.push_back(file.path());
+            } else if (file.path().extension() == kTempSuffix && mode_ == Mode::kReadWrite) {
+                // Chunk creation interrupted before its header was written
+                std::error_code ignored;
+                fs::remove(file.path(), ignored);
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& file : files) {
+            Chunk chunk;
+            if (!chunk.map(file.string(), false)) {
+                return false;
+            }
+            const ChunkHeader& h = chunk.header();
+            if (h.device != device) {
+                std::fprintf(stderr, "%s: belongs to device %u\n", file.c_str(), h.device);
+                return false;
+            }
+            Series* series = seriesFor({h.device, h.sensor});
+            series->chunks.push_back({file.string(), h.min_us, h.max_us});
+        }
+    }
+    if (ec) {
+        std::fprintf(stderr, "%s: %s\n", root_.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    if (mode_ == Mode::kReadWrite) {
+        for (auto& entry : series_) {
+            Series& series = *entry.second;
+            auto chunk = std::make_unique<Chunk>();
+            if (!chunk->map(series.chunks.back().path, true)) {
+                return false;
+            }
+            const ChunkHeader& h = chunk->header();
+            if (h.count.load(std::memory_order_relaxed) < h.capacity) {
+                series.active = std::move(chunk);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get or create the series, creating its directory in kReadWrite mode
+ *
+ * The map is looked up under a shared lock; only the first datagram of a
+ * new series takes the exclusive lock.
+ */
+TimeSeriesStore::Series* TimeSeriesStore::seriesFor(const SeriesKey& key) {
+    {
+        std::shared_lock<std::shared_mutex> lock(series_mutex_);
+        auto it = series_.find(key);
+        if (it != series_.end()) {
+            return it->second.get();
+        }
+    }
+
+    if (mode_ == Mode::kReadWrite) {
+        std::error_code ec;
+        fs::create_directories(root_ + "/" + std::to_string(key.device), ec);
+        if (ec) {
+            std::fprintf(stderr, "%s/%u: %s\n", root_.c_str(), key.device,
+                         ec.message().c_str());
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(series_mutex_);
+    auto& series = series_[key];
+    if (!series) {
+        series = std::make_unique<Series>();
+        series->key = key;
+    }
+    return series.get();
+}
+
+const TimeSeriesStore::Series* TimeSeriesStore::find(const SeriesKey& key) const {
+    std::shared_lock<std::shared_mutex> lock(series_mutex_);
+    auto it = series_.find(key);
+    return it != series_.end() ? it->second.get() : nullptr;
+}
+
+/**
+ * @brief Append the samples of one decoded datagram
+ *
+ * Capture times are taken from the device clock when it is aligned
+ * (kFlagClockSynced). Otherwise the uptime differences within the datagram
+ * are kept and the newest sample is placed at the arrival time, which is
+ * late by the batching delay. A replayed datagram (kFlagBackfill) may have
+ * been captured hours before it arrives; without a clock offset it would
+ * be stored at the wrong time for good, so it is rejected instead.
+ */
+AppendResult TimeSeriesStore::append(const WirePacketHeader& header, const WireSample* samples,
+                                     int64_t ingest_unix_us) {
+    if (mode_ != Mode::kReadWrite || header.count == 0) {
+        return AppendResult::kOk;
+    }
+
+    int64_t offset = header.clock_offset;
+    if ((header.flags & kFlagClockSynced) == 0) {
+        if ((header.flags & kFlagBackfill) != 0) {
+            return AppendResult::kUntimed;
+        }
+        offset = ingest_unix_us - static_cast<int64_t>(samples[header.count - 1].timestamp_us);
+    }
+
+    AppendResult result = AppendResult::kOk;
+    Series* series = nullptr;
+    for (size_t i = 0; i < header.count; ++i) {
+        const SeriesKey key{header.device_id, samples[i].sensor};
+        if (series == nullptr || !(series->key == key)) {
+            series = seriesFor(key);
+        }
+        const int64_t timestamp = static_cast<int64_t>(samples[i].timestamp_us) + offset;
+
+        std::lock_guard<std::mutex> lock(series->mutex);
+        if (!appendRow(*series, timestamp, samples[i].temperature, samples[i].humidity)) {
+            result = AppendResult::kError;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Append one row, opening a new chunk when the active one is full
+ *
+ * The columns are written first and count is published with release
+ * order, so readers that load count with acquire see complete rows only.
+ * Called with the series mutex held.
+ */
+bool TimeSeriesStore::appendRow(Series& series, int64_t timestamp_us, int16_t temperature,
+                                uint16_t humidity) {
+    Chunk* chunk = series.active.get();
+    if (chunk == nullptr ||
+        chunk->header().count.load(std::memory_order_relaxed) == chunk->header().capacity) {
+        auto next = std::make_unique<Chunk>();
+        const std::string path = chunk_path(root_, series.key, series.chunks.size());
+        if (!next->create(path, series.key, chunk_capacity_)) {
+            return false;
+        }
+        series.chunks.push_back({path, INT64_MAX, INT64_MIN});
+        series.active = std::move(next);
+        chunk = series.active.get();
+    }
+
+    ChunkHeader& h = chunk->header();
+    const uint32_t row = h.count.load(std::memory_order_relaxed);
+    chunk->timestamps()[row] = timestamp_us;
+    chunk->temperatures()[row] = temperature;
+    chunk->humidities()[row] = humidity;
+
+    if (row > 0 && timestamp_us < h.max_us) {
+        h.flags |= kChunkUnsorted;
+    }
+    h.min_us = std::min(h.min_us, timestamp_us);
+    h.max_us = std::max(h.max_us, timestamp_us);
+    h.count.store(row + 1, std::memory_order_release);
+
+    ChunkInfo& info = series.chunks.back();
+    info.min_us = h.min_us;
+    info.max_us = h.max_us;
+    appended_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief List all series with their row counts and time ranges
+ *
+ * Row counts come from the chunk headers, so they include rows appended
+ * by a writer process since this store was opened.
+ */
+std::vector<TimeSeriesStore::SeriesInfo> TimeSeriesStore::series() const {
+    std::vector<SeriesKey> keys;
+    {
+        std::shared_lock<std::shared_mutex> lock(series_mutex_);
+        for (const auto& entry : series_) {
+            keys.push_back(entry.first);
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [](const SeriesKey& a, const SeriesKey& b) {
+        return a.device != b.device ? a.device < b.device : a.sensor < b.sensor;
+    });
+
+    std::vector<SeriesInfo> result;
+    for (const auto& key : keys) {
+        SeriesInfo info{key, 0, 0, INT64_MAX, INT64_MIN};
+        forEachChunk(key, INT64_MIN, INT64_MAX, [&](const Chunk& chunk, uint32_t count) {
+            info.rows += count;
+            info.chunks++;
+            if (count > 0) {
+                info.first_us = std::min(info.first_us, chunk.header().min_us);
+                info.last_us = std::max(info.last_us, chunk.header().max_us);
+            }
+        });
+        result.push_back(info);
+    }
+    return result;
+}
+
+/**
+ * @brief Min/mean/max per bucket_us-long bucket of one series
+ *
+ * In time-ordered chunks the rows of a bucket are contiguous: the bucket
+ * boundaries are found by binary search on the timestamp column and the
+ * temperature and humidity slices in between are folded with vectorizable
+ * loops, without touching the timestamps again. Unsorted chunks are
+ * bucketed row by row.
+ */
+std::vector<Bucket> TimeSeriesStore::downsample(const SeriesKey& key, int64_t from_us,
+                                                int64_t to_us, int64_t bucket_us,
+                                                ScanStats* stats) const {
+    std::vector<Bucket> buckets;
+    if (bucket_us <= 0 || to_us <= from_us) {
+        return buckets;
+    }
+    const uint64_t span = static_cast<uint64_t>(to_us) - static_cast<uint64_t>(from_us);
+    buckets.resize((span + static_cast<uint64_t>(bucket_us) - 1) / bucket_us);
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        buckets[b].start_us = from_us + static_cast<int64_t>(b) * bucket_us;
+    }
+
+    ScanStats scan;
+    forEachChunk(key, from_us, to_us, [&](const Chunk& chunk, uint32_t count) {
+        const int64_t* ts = chunk.timestamps();
+        const int16_t* temperature = chunk.temperatures();
+        const uint16_t* humidity = chunk.humidities();
+        scan.chunks++;
+
+        if ((chunk.header().flags & kChunkUnsorted) != 0) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (ts[i] >= from_us && ts[i] < to_us) {
+                    fold(buckets[(ts[i] - from_us) / bucket_us], &temperature[i], &humidity[i], 1);
+                    scan.rows++;
+                }
+            }
+            scan.bytes += static_cast<uint64_t>(count) * 12;
+            return;
+        }
+
+        const int64_t* begin = std::lower_bound(ts, ts + count, from_us);
+        const int64_t* end = std::lower_bound(begin, ts + count, to_us);
+        while (begin < end) {
+            const size_t b = static_cast<size_t>((*begin - from_us) / bucket_us);
+            const int64_t bucket_end = to_us - buckets[b].start_us > bucket_us
+                                           ? buckets[b].start_us + bucket_us
+                                           : to_us;
+            const int64_t* last = std::lower_bound(begin, end, bucket_end);
+            const size_t first = static_cast<size_t>(begin - ts);
+            const size_t n = static_cast<size_t>(last - begin);
+            fold(buckets[b], &temperature[first], &humidity[first], n);
+            scan.rows += n;
+            scan.bytes += n * (sizeof(int16_t) + sizeof(uint16_t));
+            begin = last;
+        }
+    });
+
+    if (stats != nullptr) {
+        *stats = scan;
+    }
+    return buckets;
+}
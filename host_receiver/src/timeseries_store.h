@@ -0,0 +1,397 @@
+/**
+ * @file timeseries_store.h
+ * @brief Columnar, memory-mapped sample store for the host-side receiver
+ *
+ * This header provides the collector's on-disk storage: decoded samples
+ * are appended per device and sensor into fixed-size chunk files that hold
+ * the timestamps, temperatures and humidities as separate arrays. Queries
+ * map the chunks and run over the columns directly, so scans and
+ * downsampling are limited by memory bandwidth instead of parsing.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sensor_protocol.h"
+
+/**
+ * @brief Identifies one series: a sensor of a device
+ */
+struct SeriesKey {
+    uint32_t device;  ///< Device ID from the datagram header
+    uint8_t sensor;   ///< Sensor index on the device
+
+    bool operator==(const SeriesKey& other) const {
+        return device == other.device && sensor == other.sensor;
+    }
+};
+
+/**
+ * @brief Fixed 64-byte header at the start of every chunk file
+ *
+ * File layout (host byte order):
+ * @code
+ * Offset               Size          Field
+ * 0                    64            ChunkHeader
+ * 64                   8 x capacity  timestamp_us  int64, capture time in us since the Unix epoch
+ * 64 + 8 x capacity    2 x capacity  temperature   int16, 0.01 degrees Celsius
+ * 64 + 10 x capacity   2 x capacity  humidity      uint16, 0.01 %RH
+ * @endcode
+ *
+ * The file has its full size from the start (sparse until written). Rows
+ * are written before count is advanced, so a reader never sees a partly
+ * written row; count may be read while the receiver is appending.
+ */
+struct ChunkHeader {
+    char magic[4];                ///< "SHTS"
+    uint16_t version;             ///< kVersion
+    uint16_t flags;               ///< kChunkUnsorted if rows are not in time order
+    uint32_t device;              ///< Device ID of the series
+    uint8_t sensor;               ///< Sensor index of the series
+    uint8_t reserved[3];          ///< Zero
+    uint32_t capacity;            ///< Rows the file has room for
+    std::atomic<uint32_t> count;  ///< Rows written
+    int64_t min_us;               ///< Earliest timestamp in the chunk
+    int64_t max_us;               ///< Latest timestamp in the chunk
+    uint8_t padding[24];          ///< Zero, up to 64 bytes
+
+    static constexpr uint16_t kVersion = 1;
+};
+
+static_assert(sizeof(ChunkHeader) == 64, "ChunkHeader must be 64 bytes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared count must be lock-free");
+
+/// ChunkHeader::flags: a row was appended with a timestamp before the latest one
+constexpr uint16_t kChunkUnsorted = 0x0001;
+
+/**
+ * @brief Outcome of TimeSeriesStore::append()
+ */
+enum class AppendResult {
+    kOk,        ///< All samples stored
+    kUntimed,   ///< Not stored: replayed before the device clock was aligned
+    kError,     ///< Not all samples stored: a chunk file could not be created
+};
+
+/**
+ * @brief Statistics of one downsampling bucket
+ */
+struct Bucket {
+    int64_t start_us = 0;         ///< Start of the bucket (Unix us)
+    uint64_t count = 0;           ///< Samples in the bucket
+    int64_t temperature_sum = 0;  ///< Sum of the temperatures (0.01 degrees Celsius)
+    int64_t humidity_sum = 0;     ///< Sum of the humidities (0.01 %RH)
+    int16_t temperature_min = INT16_MAX;
+    int16_t temperature_max = INT16_MIN;
+    uint16_t humidity_min = UINT16_MAX;
+    uint16_t humidity_max = 0;
+};
+
+/**
+ * @brief Appends samples into columnar chunk files and answers range queries
+ *
+ * Directory layout: <root>/<device>/<sensor>-<sequence>.chunk, one
+ * sequence of chunks per series. Every chunk holds up to chunk_capacity
+ * rows; a full chunk is closed and the next one created. Samples are
+ * stored with their capture time in Unix microseconds: sample timestamp
+ * plus clock offset for devices aligned via SNTP, otherwise estimated from
+ * the arrival time (the newest sample of a datagram is taken as captured
+ * on arrival). Datagrams replayed from the device's flash store without
+ * an aligned clock have no usable capture time and are not stored.
+ *
+ * The index is the list of chunks per series with their time range, built
+ * from the chunk headers when the store is opened. Queries skip chunks
+ * outside the requested range, find the first and last row with a binary
+ * search in time-ordered chunks and then run over contiguous column
+ * slices. Late data (reordered or replayed datagrams) is appended as it
+ * arrives; the chunk is then flagged unsorted and scanned row by row.
+ *
+ * One process opens a store for writing (guarded by a lock file); any
+ * number of processes may query it at the same time. append() may be
+ * called from several receive workers concurrently. Window summaries are
+ * not stored.
+ *
+ * Usage example:
+ * @code
+ * TimeSeriesStore store("/var/lib/sensors");
+ * store.open(TimeSeriesStore::Mode::kReadWrite);
+ * store.append(header, samples, ingest_unix_us);
+ *
+ * TimeSeriesStore reader("/var/lib/sensors");
+ * reader.open(TimeSeriesStore::Mode::kReadOnly);
+ * auto hourly = reader.downsample({1, 0}, from_us, to_us, 3600000000LL);
+ * @endcode
+ */
+class TimeSeriesStore {
+public:
+    /// Rows per chunk file: three days at 1 Hz, 3 MB per file
+    static constexpr uint32_t kDefaultChunkCapacity = 1u << 18;
+
+    /// How a store is opened
+    enum class Mode {
+        kReadOnly,   ///< Queries only, any number of processes
+        kReadWrite,  ///< Appends and queries, one process
+    };
+
+    /**
+     * @brief Summary of one series from the index
+     */
+    struct SeriesInfo {
+        SeriesKey key;     ///< Device and sensor
+        uint64_t rows;     ///< Stored samples
+        size_t chunks;     ///< Chunk files
+        int64_t first_us;  ///< Earliest timestamp
+        int64_t last_us;   ///< Latest timestamp
+    };
+
+    /**
+     * @brief Amount of data a query ran over
+     */
+    struct ScanStats {
+        uint64_t rows = 0;     ///< Rows inside the range
+        uint64_t bytes = 0;    ///< Column bytes read
+        size_t chunks = 0;     ///< Chunks mapped
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param root           Store directory, created by open() in kReadWrite mode
+     * @param chunk_capacity Rows per new chunk file (a multiple of 64)
+     */
+    explicit TimeSeriesStore(std::string root, uint32_t chunk_capacity = kDefaultChunkCapacity);
+
+    /**
+     * @brief Destructor - close the open chunks and release the lock
+     */
+    ~TimeSeriesStore();
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    /**
+     * @brief Open the store and build the index from the chunk headers
+     *
+     * @param mode kReadWrite creates the directory and takes the writer lock
+     *
+     * @return false if the directory cannot be used, another writer holds
+     *         the lock or a chunk file is corrupt
+     */
+    bool open(Mode mode);
+
+    /**
+     * @brief Append the samples of one decoded datagram
+     *
+     * @param header         Decoded datagram header (device ID, clock offset)
+     * @param samples        Decoded samples
+     * @param ingest_unix_us Arrival time in us since the Unix epoch
+     *
+     * @return AppendResult::kOk if stored, kUntimed for a replayed datagram
+     *         without clock offset, kError if a chunk file could not be
+     *         created (samples are lost)
+     */
+    AppendResult append(const WirePacketHeader& header, const WireSample* samples,
+                int64_t ingest_unix_us);
+
+    /**
+     * @brief List all series with their row counts and time ranges
+     */
+    std::vector<SeriesInfo> series() const;
+
+    /**
+     * @brief Visit the rows of one series within [from_us, to_us)
+     *
+     * Rows of time-ordered chunks are visited in time order.
+     *
+     * @param key     Series to read
+     * @param from_us Start of the range (inclusive)
+     * @param to_us   End of the range (exclusive)
+     * @param fn      Called as fn(timestamp_us, temperature, humidity) per row
+     *
+     * @return Scan statistics
+     */
+    template <typename Fn>
+    ScanStats select(const SeriesKey& key, int64_t from_us, int64_t to_us, Fn&& fn) const;
+
+    /**
+     * @brief Min/mean/max per bucket_us-long bucket of one series
+     *
+     * @param key       Series to read
+     * @param from_us   Start of the range and of the first bucket
+     * @param to_us     End of the range (exclusive)
+     * @param bucket_us Bucket length in us
+     * @param stats     Receives the scan statistics, may be nullptr
+     *
+     * @return One entry per bucket in the range, empty buckets have count 0
+     */
+    std::vector<Bucket> downsample(const SeriesKey& key, int64_t from_us, int64_t to_us,
+                                   int64_t bucket_us, ScanStats* stats = nullptr) const;
+
+    /**
+     * @brief Samples appended since open()
+     */
+    uint64_t appended() const {
+        return appended_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief Read-only or read-write mapping of one chunk file
+     */
+    class Chunk {
+    public:
+        Chunk() = default;
+        ~Chunk();
+
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+
+        /// Create a new, empty chunk file of the given capacity
+        bool create(const std::string& path, const SeriesKey& key, uint32_t capacity);
+
+        /// Map an existing chunk file
+        bool map(const std::string& path, bool writable);
+
+        ChunkHeader& header() const {
+            return *reinterpret_cast<ChunkHeader*>(base_);
+        }
+        int64_t* timestamps() const {
+            return reinterpret_cast<int64_t*>(base_ + sizeof(ChunkHeader));
+        }
+        int16_t* temperatures() const {
+            return reinterpret_cast<int16_t*>(timestamps() + header().capacity);
+        }
+        uint16_t* humidities() const {
+            return reinterpret_cast<uint16_t*>(temperatures() + header().capacity);
+        }
+
+        /// File size for a given capacity
+        static size_t fileSize(uint32_t capacity) {
+            return sizeof(ChunkHeader) + static_cast<size_t>(capacity) * 12;
+        }
+
+    private:
+        uint8_t* base_ = nullptr;  ///< Start of the mapping
+        size_t size_ = 0;          ///< Length of the mapping
+    };
+
+    /// Index entry of one chunk file
+    struct ChunkInfo {
+        std::string path;  ///< Chunk file
+        int64_t min_us;    ///< Earliest timestamp when indexed
+        int64_t max_us;    ///< Latest timestamp when indexed
+    };
+
+    /// Index and writer state of one series
+    struct Series {
+        SeriesKey key;
+        std::vector<ChunkInfo> chunks;  ///< Index, in sequence order
+        std::unique_ptr<Chunk> active;  ///< Chunk being appended to (kReadWrite)
+        mutable std::mutex mutex;       ///< Serializes appends and index updates
+    };
+
+    /// Hash of a SeriesKey for the series map
+    struct KeyHash {
+        size_t operator()(const SeriesKey& key) const {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(key.device) << 8) | key.sensor);
+        }
+    };
+
+    /// Get or create the series, creating its directory in kReadWrite mode
+    Series* seriesFor(const SeriesKey& key);
+
+    /// Find an existing series
+    const Series* find(const SeriesKey& key) const;
+
+    /// Append one row, opening a new chunk when the active one is full
+    bool appendRow(Series& series, int64_t timestamp_us, int16_t temperature, uint16_t humidity);
+
+    /// Map the chunks of a series overlapping [from_us, to_us) and pass them to fn
+    template <typename Fn>
+    void forEachChunk(const SeriesKey& key, int64_t from_us, int64_t to_us, Fn&& fn) const;
+
+    /// Index all chunk files below root_
+    bool scan();
+
+    std::string root_;         ///< Store directory
+    uint32_t chunk_capacity_;  ///< Rows per new chunk
+    Mode mode_ = Mode::kReadOnly;
+    int lock_fd_ = -1;         ///< Writer lock file
+
+    mutable std::shared_mutex series_mutex_;  ///< Guards the series_ map itself
+    std::unordered_map<SeriesKey, std::unique_ptr<Series>, KeyHash> series_;
+    std::atomic<uint64_t> appended_{0};  ///< Samples appended since open()
+};
+
+/**
+ * @brief Map the chunks of a series that overlap [from_us, to_us)
+ *
+ * The last chunk is always mapped since it may have grown since it was
+ * indexed. fn is called as fn(const Chunk&, uint32_t count) with the row
+ * count read once per chunk.
+ */
+template <typename Fn>
+void TimeSeriesStore::forEachChunk(const SeriesKey& key, int64_t from_us, int64_t to_us,
+                                   Fn&& fn) const {
+    const Series* series = find(key);
+    if (series == nullptr) {
+        return;
+    }
+
+    std::vector<ChunkInfo> chunks;
+    {
+        std::lock_guard<std::mutex> lock(series->mutex);
+        chunks = series->chunks;
+    }
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const bool last = i + 1 == chunks.size();
+        if (!last && (chunks[i].min_us >= to_us || chunks[i].max_us < from_us)) {
+            continue;
+        }
+        Chunk chunk;
+        if (!chunk.map(chunks[i].path, false)) {
+            continue;
+        }
+        const uint32_t count = chunk.header().count.load(std::memory_order_acquire);
+        fn(chunk, count);
+    }
+}
+
+template <typename Fn>
+TimeSeriesStore::ScanStats TimeSeriesStore::select(const SeriesKey& key, int64_t from_us,
+                                                   int64_t to_us, Fn&& fn) const {
+    ScanStats stats;
+    forEachChunk(key, from_us, to_us, [&](const Chunk& chunk, uint32_t count) {
+        const int64_t* ts = chunk.timestamps();
+        const int16_t* temperature = chunk.temperatures();
+        const uint16_t* humidity = chunk.humidities();
+        stats.chunks++;
+
+        size_t begin = 0;
+        size_t end = count;
+        const bool sorted = (chunk.header().flags & kChunkUnsorted) == 0;
+        if (sorted) {
+            begin = std::lower_bound(ts, ts + count, from_us) - ts;
+            end = std::lower_bound(ts + begin, ts + count, to_us) - ts;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            if (sorted || (ts[i] >= from_us && ts[i] < to_us)) {
+                fn(ts[i], temperature[i], humidity[i]);
+                stats.rows++;
+            }
+        }
+        stats.bytes += (end - begin) * 12;
+    });
+    return stats;
+}
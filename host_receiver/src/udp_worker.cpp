@@ -0,0 +1,153 @@
+/**
+ * @file udp_worker.cpp
+ * @brief Implementation of the batched UDP receive worker
+ */
+
+#include "udp_worker.h"
+
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Constructor - prepare receive buffers
+ *
+ * All buffers are allocated once; the receive loop itself does not allocate.
+ */
+UdpWorker::UdpWorker(uint16_t port, size_t batch, TimeSeriesStore* store)
+    : port_(port),
+      batch_(batch),
+      buffers_(batch * kMaxDatagram),
+      iovecs_(batch),
+      msgs_(batch),
+      samples_(SensorProtocol::kMaxSamples),
+      aggregates_(SensorProtocol::kMaxSamples),
+      store_(store) {
+    for (size_t i = 0; i < batch_; ++i) {
+        iovecs_[i].iov_base = &buffers_[i * kMaxDatagram];
+        iovecs_[i].iov_len = kMaxDatagram;
+        std::memset(&msgs_[i], 0, sizeof(msgs_[i]));
+        msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+/**
+ * @brief Destructor - close the socket
+ */
+UdpWorker::~UdpWorker() {
+    if (sock_ >= 0) {
+        close(sock_);
+    }
+}
+
+/**
+ * @brief Create and bind the SO_REUSEPORT socket
+ *
+ * A receive timeout lets run() observe the stop flag while idle. The
+ * receive buffer is enlarged to absorb bursts from many boards.
+ *
+ * @return true if the socket is ready to receive
+ */
+bool UdpWorker::open() {
+    sock_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock_ < 0) {
+        std::perror("socket");
+        return false;
+    }
+
+    int one = 1;
+    if (setsockopt(sock_, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+        std::perror("setsockopt(SO_REUSEPORT)");
+        return false;
+    }
+
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(sock_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct timeval timeout = {0, 100 * 1000};
+    setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(sock_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::perror("bind");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Receive loop, returns once @p stop becomes true
+ *
+ * MSG_WAITFORONE blocks until the first datagram arrives and then returns
+ * everything else already queued, up to batch_ datagrams per system call.
+ */
+void UdpWorker::run(const std::atomic<bool>& stop) {
+    while (!stop.load(std::memory_order_relaxed)) {
+        const int n = recvmmsg(sock_, msgs_.data(), static_cast<unsigned>(batch_),
+                               MSG_WAITFORONE, nullptr);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::perror("recvmmsg");
+            }
+            continue;
+        }
+
+        counters_.syscalls.fetch_add(1, std::memory_order_relaxed);
+        for (int i = 0; i < n; ++i) {
+            handle(static_cast<const uint8_t*>(iovecs_[i].iov_base), msgs_[i].msg_len);
+        }
+    }
+}
+
+/**
+ * @brief Decode and account one datagram
+ */
+void UdpWorker::handle(const uint8_t* data, size_t len) {
+    counters_.bytes.fetch_add(len, std::memory_order_relaxed);
+
+    WirePacketHeader header;
+    if (!SensorProtocol::decodeHeader(data, len, header)) {
+        counters_.malformed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (header.type == kPacketAggregates) {
+        if (!SensorProtocol::decodeAggregates(data, len, header, aggregates_.data(),
+                                              aggregates_.size())) {
+            counters_.malformed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        tracker_.update(header, aggregates_.data(), std::chrono::steady_clock::now());
+        counters_.aggregates.fetch_add(header.count, std::memory_order_relaxed);
+    } else {
+        if (!SensorProtocol::decode(data, len, header, samples_.data(), samples_.size())) {
+            counters_.malformed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto ingest = std::chrono::system_clock::now().time_since_epoch();
+        const int64_t ingest_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(ingest).count();
+        const bool fresh =
+            tracker_.update(header, samples_.data(), std::chrono::steady_clock::now(), ingest_us);
+        // A repeated datagram would store its samples twice
+        if (store_ != nullptr && fresh) {
+            const AppendResult stored = store_->append(header, samples_.data(), ingest_us);
+            if (stored == AppendResult::kUntimed) {
+                counters_.untimed.fetch_add(header.count, std::memory_order_relaxed);
+            } else if (stored == AppendResult::kError) {
+                counters_.unstored.fetch_add(header.count, std::memory_order_relaxed);
+            }
+        }
+        counters_.samples.fetch_add(header.count, std::memory_order_relaxed);
+    }
+    counters_.datagrams.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file udp_worker.h
+ * @brief Batched UDP receive worker for the host-side receiver
+ *
+ * This header provides one receive worker: a UDP socket bound with
+ * SO_REUSEPORT that pulls datagrams in batches with recvmmsg(), decodes
+ * them with SensorProtocol, accounts them in its DeviceTracker and
+ * optionally appends the samples to a TimeSeriesStore.
+ */
+
+#pragma once
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "device_tracker.h"
+#include "timeseries_store.h"
+
+/**
+ * @brief One SO_REUSEPORT socket plus the thread-local decode state
+ *
+ * Several workers bind the same port; the kernel spreads incoming
+ * datagrams across their sockets by source address hash. Each worker is
+ * driven by exactly one thread via run().
+ *
+ * Usage example:
+ * @code
+ * UdpWorker worker(8888, 64);
+ * if (worker.open()) {
+ *     std::thread t([&] { worker.run(stop); });
+ * }
+ * @endcode
+ */
+class UdpWorker {
+public:
+    /**
+     * @brief Receive counters, readable from other threads while running
+     */
+    struct Counters {
+        std::atomic<uint64_t> datagrams{0};  ///< Valid datagrams decoded
+        std::atomic<uint64_t> samples{0};    ///< Samples decoded
+        std::atomic<uint64_t> aggregates{0}; ///< Window summaries decoded
+        std::atomic<uint64_t> bytes{0};      ///< Payload bytes received
+        std::atomic<uint64_t> malformed{0};  ///< Datagrams rejected by the decoder
+        std::atomic<uint64_t> syscalls{0};   ///< recvmmsg() calls returning data
+        std::atomic<uint64_t> unstored{0};   ///< Samples the store failed to append
+        std::atomic<uint64_t> untimed{0};    ///< Replayed samples not stored, no capture time
+    };
+
+    /**
+     * @brief Constructor - prepare receive buffers
+     *
+     * @param port  UDP port to bind (shared by all workers)
+     * @param batch Maximum number of datagrams per recvmmsg() call
+     * @param store Store for the decoded samples (shared by all workers), nullptr for none
+     */
+    UdpWorker(uint16_t port, size_t batch, TimeSeriesStore* store = nullptr);
+
+    /**
+     * @brief Destructor - close the socket
+     */
+    ~UdpWorker();
+
+    UdpWorker(const UdpWorker&) = delete;
+    UdpWorker& operator=(const UdpWorker&) = delete;
+
+    /**
+     * @brief Create and bind the SO_REUSEPORT socket
+     *
+     * @return true if the socket is ready to receive
+     */
+    bool open();
+
+    /**
+     * @brief Receive loop, returns once @p stop becomes true
+     *
+     * @param stop Shared stop flag, checked at least every 100 ms
+     */
+    void run(const std::atomic<bool>& stop);
+
+    /**
+     * @brief Get the receive counters
+     */
+    const Counters& counters() const {
+        return counters_;
+    }
+
+    /**
+     * @brief Get the per-device state of this worker
+     */
+    const DeviceTracker& tracker() const {
+        return tracker_;
+    }
+
+private:
+    /// Maximum UDP payload accepted per datagram
+    static constexpr size_t kMaxDatagram = 2048;
+
+    /// Decode and account one datagram
+    void handle(const uint8_t* data, size_t len);
+
+    uint16_t port_;                     ///< Bound UDP port
+    size_t batch_;                      ///< Datagrams per recvmmsg() call
+    int sock_ = -1;                     ///< Socket file descriptor
+    std::vector<uint8_t> buffers_;      ///< batch_ x kMaxDatagram receive buffers
+    std::vector<struct iovec> iovecs_;  ///< One iovec per buffer
+    std::vector<struct mmsghdr> msgs_;  ///< recvmmsg() message vector
+    std::vector<WireSample> samples_;   ///< Decode scratch space
+    std::vector<WireAggregate> aggregates_;  ///< Decode scratch space for summaries
+    Counters counters_;                 ///< Receive counters
+    DeviceTracker tracker_;             ///< Per-device state
+    TimeSeriesStore* store_;            ///< Sample store, nullptr if disabled
+};
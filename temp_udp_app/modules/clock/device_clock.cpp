@@ -0,0 +1,196 @@
+/**
+ * @file device_clock.cpp
+ * @brief Implementation of the device clock, the SNTP alignment and "sensor time"
+ */
+
+#include "device_clock.h"
+
+#include <zephyr/logging/log.h>
+#include <zephyr/random/random.h>
+
+#if defined(CONFIG_APP_TIME_SYNC)
+#include <zephyr/net/sntp.h>
+#include <zephyr/net/socket.h>
+#endif
+
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_REGISTER(device_clock);
+
+/// Guards the offset and the statistics (64-bit values on a 32-bit CPU)
+static struct k_spinlock clock_lock;
+
+static uint32_t boot_id;
+static bool offset_valid;
+static int64_t offset_us;
+static DeviceClock::SyncStats sync_stats;
+
+#if defined(CONFIG_APP_TIME_SYNC)
+/// Retry interval until the first successful exchange
+static constexpr int32_t kRetryMs = 5000;
+
+K_THREAD_STACK_DEFINE(time_sync_stack, CONFIG_APP_TIME_SYNC_STACK_SIZE);
+static struct k_thread time_sync_thread;
+
+/**
+ * @brief Run one SNTP exchange and update the offset
+ *
+ * The server time is taken as valid at the midpoint between sending the
+ * request and receiving the response.
+ *
+ * @return true if the exchange succeeded
+ */
+static bool sync_once() {
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(CONFIG_APP_TIME_SYNC_PORT);
+    if (zsock_inet_pton(AF_INET, CONFIG_APP_TIME_SYNC_SERVER, &addr.sin_addr) != 1) {
+        LOG_ERR("Invalid SNTP server address: %s", CONFIG_APP_TIME_SYNC_SERVER);
+        return false;
+    }
+
+    struct sntp_ctx ctx;
+    int rc = sntp_init(&ctx, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    if (rc < 0) {
+        return false;
+    }
+
+    struct sntp_time time;
+    const uint64_t sent = DeviceClock::nowUs();
+    rc = sntp_query(&ctx, CONFIG_APP_TIME_SYNC_TIMEOUT_MS, &time);
+    const uint64_t received = DeviceClock::nowUs();
+    sntp_close(&ctx);
+    if (rc < 0) {
+        return false;
+    }
+
+    // The fraction is in units of 2^-32 s
+    const uint64_t fraction_us = (static_cast<uint64_t>(time.fraction) * USEC_PER_SEC) >> 32;
+    const int64_t server_us = static_cast<int64_t>(time.seconds * USEC_PER_SEC + fraction_us);
+    const int64_t midpoint = static_cast<int64_t>(sent + (received - sent) / 2);
+    const int64_t offset = server_us - midpoint;
+
+    k_spinlock_key_t key = k_spin_lock(&clock_lock);
+    sync_stats.last_step_us = offset_valid ? offset - offset_us : 0;
+    sync_stats.last_rtt_us = static_cast<uint32_t>(received - sent);
+    sync_stats.last_sync_ms = k_uptime_get();
+    sync_stats.syncs++;
+    offset_us = offset;
+    offset_valid = true;
+    k_spin_unlock(&clock_lock, key);
+    return true;
+}
+
+/**
+ * @brief SNTP thread entry point
+ *
+ * Retries every kRetryMs until the first exchange succeeds, then
+ * re-aligns every CONFIG_APP_TIME_SYNC_INTERVAL_S.
+ */
+static void time_sync_entry(void*, void*, void*) {
+    while (true) {
+        if (sync_once()) {
+            const DeviceClock::SyncStats stats = DeviceClock::syncStats();
+            if (stats.syncs == 1) {
+                LOG_INF("Clock aligned with %s, round trip %u us", CONFIG_APP_TIME_SYNC_SERVER,
+                        stats.last_rtt_us);
+            } else {
+                LOG_DBG("Clock re-aligned: step %d us, round trip %u us",
+                        static_cast<int>(stats.last_step_us), stats.last_rtt_us);
+            }
+        } else {
+            k_spinlock_key_t key = k_spin_lock(&clock_lock);
+            const uint32_t failures = ++sync_stats.failures;
+            k_spin_unlock(&clock_lock, key);
+            if (failures == 1) {
+                LOG_WRN("No response from SNTP server %s:%d, retrying",
+                        CONFIG_APP_TIME_SYNC_SERVER, CONFIG_APP_TIME_SYNC_PORT);
+            }
+        }
+
+        k_sleep(DeviceClock::synced() ? K_SECONDS(CONFIG_APP_TIME_SYNC_INTERVAL_S)
+                                      : K_MSEC(kRetryMs));
+    }
+}
+#endif
+
+/**
+ * @brief Pick the boot ID and start the SNTP thread (if enabled)
+ */
+void DeviceClock::init() {
+    // 0 is reserved for "unknown" at the collector
+    do {
+        boot_id = sys_rand32_get();
+    } while (boot_id == 0);
+
+    LOG_INF("Boot ID %08x", boot_id);
+
+#if defined(CONFIG_APP_TIME_SYNC)
+    k_thread_create(&time_sync_thread, time_sync_stack, K_THREAD_STACK_SIZEOF(time_sync_stack),
+                    time_sync_entry, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+                    K_NO_WAIT);
+    k_thread_name_set(&time_sync_thread, "time_sync");
+#endif
+}
+
+uint32_t DeviceClock::bootId() {
+    return boot_id;
+}
+
+bool DeviceClock::synced() {
+    k_spinlock_key_t key = k_spin_lock(&clock_lock);
+    const bool valid = offset_valid;
+    k_spin_unlock(&clock_lock, key);
+    return valid;
+}
+
+int64_t DeviceClock::offsetUs() {
+    k_spinlock_key_t key = k_spin_lock(&clock_lock);
+    const int64_t offset = offset_valid ? offset_us : 0;
+    k_spin_unlock(&clock_lock, key);
+    return offset;
+}
+
+DeviceClock::SyncStats DeviceClock::syncStats() {
+    k_spinlock_key_t key = k_spin_lock(&clock_lock);
+    const SyncStats stats = sync_stats;
+    k_spin_unlock(&clock_lock, key);
+    return stats;
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief "sensor time" - print boot ID, uptime and the SNTP alignment
+ */
+static int cmd_sensor_time(const struct shell* sh, size_t argc, char** argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    const uint64_t now = DeviceClock::nowUs();
+    shell_print(sh, "boot ID:     %08x", DeviceClock::bootId());
+    shell_print(sh, "uptime:      %llu us", static_cast<unsigned long long>(now));
+
+    if (!DeviceClock::synced()) {
+        shell_print(sh, "SNTP:        %s", IS_ENABLED(CONFIG_APP_TIME_SYNC) ? "not synced"
+                                                                          : "disabled");
+        return 0;
+    }
+
+    const DeviceClock::SyncStats stats = DeviceClock::syncStats();
+    const int64_t unix_us = static_cast<int64_t>(now) + DeviceClock::offsetUs();
+    shell_print(sh, "Unix time:   %lld.%06lld s", static_cast<long long>(unix_us / USEC_PER_SEC),
+                static_cast<long long>(unix_us % USEC_PER_SEC));
+    shell_print(sh, "SNTP:        %u syncs, %u failures, last %lld ms ago", stats.syncs,
+                stats.failures, static_cast<long long>(k_uptime_get() - stats.last_sync_ms));
+    shell_print(sh, "last sync:   round trip %u us, step %lld us", stats.last_rtt_us,
+                static_cast<long long>(stats.last_step_us));
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), time, NULL,
+                 "Boot ID, uptime and SNTP clock alignment\n"
+                 "Usage: sensor time",
+                 cmd_sensor_time, 1, 0);
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file device_clock.h
+ * @brief Time base of the device: microsecond capture clock, boot ID and SNTP offset
+ *
+ * This header provides the clock every sample timestamp is taken from,
+ * the random boot ID that tells the collector one boot of a device from
+ * the next, and the optional alignment of the clock with an SNTP server
+ * so that the collector can measure the latency from capture to ingest.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstdint>
+
+/**
+ * @brief Device-wide capture clock (all members are static)
+ *
+ * Timestamps are microseconds since boot derived from the kernel uptime
+ * ticks, so they are 64-bit (no wrap-around), monotonic and in the same
+ * time base as k_uptime_get() and the sensor API frame timestamps. The
+ * resolution is one tick (1 / CONFIG_SYS_CLOCK_TICKS_PER_SEC).
+ *
+ * With CONFIG_APP_TIME_SYNC a low-priority thread queries the SNTP server
+ * CONFIG_APP_TIME_SYNC_SERVER every CONFIG_APP_TIME_SYNC_INTERVAL_S and
+ * keeps the offset from uptime to Unix time. The offset is estimated at
+ * the midpoint of the request, so its uncertainty is half the round trip.
+ * The device clock itself is never stepped: timestamps stay monotonic and
+ * the offset is sent along in every datagram header.
+ *
+ * Usage example:
+ * @code
+ * DeviceClock::init();
+ *
+ * data.timestamp_us = DeviceClock::nowUs();
+ * if (DeviceClock::synced()) {
+ *     int64_t unix_us = static_cast<int64_t>(data.timestamp_us) + DeviceClock::offsetUs();
+ * }
+ * @endcode
+ */
+class DeviceClock {
+public:
+    /**
+     * @brief SNTP alignment statistics
+     */
+    struct SyncStats {
+        uint32_t syncs;         ///< Successful SNTP exchanges
+        uint32_t failures;      ///< Failed or timed out SNTP exchanges
+        uint32_t last_rtt_us;   ///< Round trip of the last successful exchange
+        int64_t last_step_us;   ///< Change of the offset by the last exchange
+        int64_t last_sync_ms;   ///< Uptime (ms) of the last successful exchange
+    };
+
+    /**
+     * @brief Pick the boot ID and start the SNTP thread (if enabled)
+     *
+     * Must be called once before the first datagram is sent.
+     */
+    static void init();
+
+    /**
+     * @brief Get the current uptime in microseconds
+     */
+    static inline uint64_t nowUs() {
+        return k_ticks_to_us_floor64(k_uptime_ticks());
+    }
+
+    /**
+     * @brief Get the random ID of this boot
+     */
+    static uint32_t bootId();
+
+    /**
+     * @brief Check whether an SNTP offset is available
+     */
+    static bool synced();
+
+    /**
+     * @brief Get the offset from uptime to Unix time in microseconds
+     *
+     * @return Unix time minus uptime (both in us), 0 if not synced
+     */
+    static int64_t offsetUs();
+
+    /**
+     * @brief Get the SNTP alignment statistics
+     */
+    static SyncStats syncStats();
+};
@@ -0,0 +1,141 @@
+/**
+ * @file periodic_scheduler.cpp
+ * @brief Implementation of the drift-free periodic scheduler and "sensor sched"
+ */
+
+#include "periodic_scheduler.h"
+
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+#include <errno.h>
+#include <cstring>
+#endif
+
+/// Scheduler shown by the shell
+static PeriodicScheduler* shell_instance;
+
+/**
+ * @brief Constructor - make this scheduler the one shown by the shell
+ */
+PeriodicScheduler::PeriodicScheduler() {
+    shell_instance = this;
+}
+
+PeriodicScheduler* PeriodicScheduler::instance() {
+    return shell_instance;
+}
+
+/**
+ * @brief Register a periodic task, due immediately
+ */
+bool PeriodicScheduler::add(const char* name, uint32_t period_ms, Callback callback,
+                            void* user) {
+    if (count_ >= kMaxTasks || period_ms == 0) {
+        return false;
+    }
+
+    Task& task = tasks_[count_];
+    task.name = name;
+    task.period_ms = period_ms;
+    task.callback = callback;
+    task.user = user;
+    task.deadline = k_uptime_get();
+    count_++;
+    return true;
+}
+
+/**
+ * @brief Run every due task and advance its deadline by whole periods
+ *
+ * Lateness is measured in microseconds against the millisecond deadline,
+ * so the tick resolution is part of the recorded jitter.
+ *
+ * @return Uptime (ms) of the earliest next deadline
+ */
+int64_t PeriodicScheduler::runDue() {
+    int64_t next = INT64_MAX;
+
+    for (size_t i = 0; i < count_; ++i) {
+        Task& task = tasks_[i];
+        const int64_t now_us = static_cast<int64_t>(k_ticks_to_us_floor64(k_uptime_ticks()));
+        const int64_t deadline_us = task.deadline * USEC_PER_MSEC;
+
+        if (now_us >= deadline_us) {
+            const int64_t late_us = now_us - deadline_us;
+            task.stats.lateness_us.record(late_us < UINT32_MAX ? static_cast<uint32_t>(late_us)
+                                                               : UINT32_MAX);
+
+            // Deadlines that passed while we were late are skipped, not caught up
+            const int64_t skipped = late_us / (static_cast<int64_t>(task.period_ms) *
+                                               USEC_PER_MSEC);
+            task.stats.misses += static_cast<uint32_t>(skipped);
+            task.deadline += (skipped + 1) * task.period_ms;
+
+            task.callback(task.user);
+            task.stats.runs++;
+        }
+
+        if (task.deadline < next) {
+            next = task.deadline;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Run the tasks forever, sleeping until the next absolute deadline
+ */
+void PeriodicScheduler::run() {
+    while (true) {
+        const int64_t next = runDue();
+        k_sleep(next == INT64_MAX ? K_FOREVER : K_TIMEOUT_ABS_MS(next));
+    }
+}
+
+void PeriodicScheduler::resetStats() {
+    for (size_t i = 0; i < count_; ++i) {
+        tasks_[i].stats.runs = 0;
+        tasks_[i].stats.misses = 0;
+        tasks_[i].stats.lateness_us.reset();
+    }
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief "sensor sched [reset]" - print or clear runs, misses and lateness per task
+ */
+static int cmd_sensor_sched(const struct shell* sh, size_t argc, char** argv) {
+    PeriodicScheduler* scheduler = PeriodicScheduler::instance();
+    if (scheduler == nullptr) {
+        shell_error(sh, "No scheduler running");
+        return -ENODEV;
+    }
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(sh, "Unknown argument: %s", argv[1]);
+            return -EINVAL;
+        }
+        scheduler->resetStats();
+        shell_print(sh, "Scheduler statistics cleared");
+        return 0;
+    }
+
+    shell_print(sh, "%-10s %10s %10s %10s %12s %12s %12s", "task", "period", "runs", "misses",
+                "p50 [us]", "p99 [us]", "max [us]");
+    for (size_t i = 0; i < scheduler->taskCount(); ++i) {
+        const PeriodicScheduler::TaskStats& stats = scheduler->stats(i);
+        shell_print(sh, "%-10s %8u ms %10u %10u %12u %12u %12u", scheduler->name(i),
+                    scheduler->period(i), stats.runs, stats.misses,
+                    stats.lateness_us.percentile(50), stats.lateness_us.percentile(99),
+                    stats.lateness_us.max());
+    }
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), sched, NULL,
+                 "Periodic task runs, deadline misses and start lateness\n"
+                 "Usage: sensor sched [reset]",
+                 cmd_sensor_sched, 1, 1);
+#endif
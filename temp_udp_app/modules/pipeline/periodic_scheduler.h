@@ -0,0 +1,147 @@
+/**
+ * @file periodic_scheduler.h
+ * @brief Drift-free scheduler for periodic tasks at independent rates
+ *
+ * This header provides a small cooperative scheduler that runs a handful of
+ * periodic callbacks in one thread. Deadlines are absolute, so the work time
+ * of a task never shifts its later runs.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "latency_histogram.h"
+
+/**
+ * @brief Runs periodic tasks on absolute deadlines
+ *
+ * The n-th run of a task is due at start + n * period. Sleeping until that
+ * point (K_TIMEOUT_ABS_MS) instead of for one period after the work keeps
+ * the average rate exact and the timestamps free of drift, independent of
+ * how long the sensor read or the other tasks took.
+ *
+ * For every run the lateness (actual start minus deadline) is recorded in
+ * a histogram; that is the release jitter of the task. If a run is so late
+ * that one or more later deadlines already passed, those runs are skipped
+ * and counted as misses; the task stays on its original phase instead of
+ * catching up with a burst.
+ *
+ * Tasks run in the order they were added when due at the same time. The
+ * most recently constructed scheduler is shown by "sensor sched".
+ *
+ * Usage example:
+ * @code
+ * PeriodicScheduler scheduler;
+ * scheduler.add("sample", 100, sampleTask, &sensors);
+ * scheduler.add("stats", 10000, statsTask, nullptr);
+ * scheduler.run();  // never returns
+ * @endcode
+ */
+class PeriodicScheduler {
+public:
+    /// Task body, called with the user pointer given to add()
+    using Callback = void (*)(void* user);
+
+    /// Maximum number of tasks per scheduler
+    static constexpr size_t kMaxTasks = 4;
+
+    /**
+     * @brief Run statistics of one task
+     */
+    struct TaskStats {
+        uint32_t runs;                ///< Completed runs
+        uint32_t misses;              ///< Runs skipped because their deadline passed
+        LatencyHistogram lateness_us; ///< Start time minus deadline per run (us)
+    };
+
+    PeriodicScheduler();
+
+    PeriodicScheduler(const PeriodicScheduler&) = delete;
+    PeriodicScheduler& operator=(const PeriodicScheduler&) = delete;
+
+    /**
+     * @brief Register a periodic task
+     *
+     * The first run is due immediately.
+     *
+     * @param name      Display name (static string)
+     * @param period_ms Period in ms, must not be 0
+     * @param callback  Task body
+     * @param user      Argument passed to the callback
+     *
+     * @return true if the task was added, false if kMaxTasks are registered
+     *         or the period is 0
+     */
+    bool add(const char* name, uint32_t period_ms, Callback callback, void* user);
+
+    /**
+     * @brief Run every task whose deadline has passed
+     *
+     * Suitable for threads that are paced by something else (e.g. the
+     * sensor's own measurement period) and only want to piggyback tasks.
+     *
+     * @return Uptime (ms) of the earliest next deadline, INT64_MAX without tasks
+     */
+    int64_t runDue();
+
+    /**
+     * @brief Run the tasks forever, sleeping until the next deadline
+     */
+    [[noreturn]] void run();
+
+    /**
+     * @brief Number of registered tasks
+     */
+    inline size_t taskCount() const {
+        return count_;
+    }
+
+    /**
+     * @brief Display name of a task
+     */
+    inline const char* name(size_t task) const {
+        return tasks_[task].name;
+    }
+
+    /**
+     * @brief Period of a task in ms
+     */
+    inline uint32_t period(size_t task) const {
+        return tasks_[task].period_ms;
+    }
+
+    /**
+     * @brief Run statistics of a task
+     */
+    inline const TaskStats& stats(size_t task) const {
+        return tasks_[task].stats;
+    }
+
+    /**
+     * @brief Clear the run statistics of all tasks
+     */
+    void resetStats();
+
+    /**
+     * @brief Scheduler shown by the shell, nullptr if none was constructed
+     */
+    static PeriodicScheduler* instance();
+
+private:
+    /// One registered task
+    struct Task {
+        const char* name;    ///< Display name
+        uint32_t period_ms;  ///< Period
+        Callback callback;   ///< Task body
+        void* user;          ///< Callback argument
+        int64_t deadline;    ///< Uptime (ms) of the next run
+        TaskStats stats;     ///< Run statistics
+    };
+
+    Task tasks_[kMaxTasks]{};  ///< Registered tasks
+    size_t count_ = 0;         ///< Number of entries in tasks_
+};
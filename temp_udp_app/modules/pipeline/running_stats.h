@@ -0,0 +1,114 @@
+/**
+ * @file running_stats.h
+ * @brief O(1)-memory running statistics (Welford)
+ *
+ * This header provides numerically stable single-pass statistics for a
+ * stream of values: count, min, max, mean and variance. Two partial results
+ * can be merged, which is what sliding windows built from panes need.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Running count/min/max/mean/variance of a value stream
+ *
+ * add() uses Welford's update, merge() the pairwise combination of Chan et
+ * al. Both avoid the cancellation of the naive sum-of-squares formula, so
+ * a small variance on top of a large mean (e.g. 0.02 degrees of noise at
+ * 23 degrees) stays accurate.
+ *
+ * Usage example:
+ * @code
+ * RunningStats stats;
+ * stats.add(23.41);
+ * stats.add(23.45);
+ * double sd = stats.stddev();
+ * @endcode
+ */
+class RunningStats {
+public:
+    /**
+     * @brief Add one value
+     */
+    void add(double value) {
+        count_++;
+        const double delta = value - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (value - mean_);
+
+        if (count_ == 1 || value < min_) {
+            min_ = value;
+        }
+        if (count_ == 1 || value > max_) {
+            max_ = value;
+        }
+    }
+
+    /**
+     * @brief Combine with the statistics of another, disjoint value stream
+     */
+    void merge(const RunningStats& other) {
+        if (other.count_ == 0) {
+            return;
+        }
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+
+        const double total = static_cast<double>(count_) + other.count_;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * other.count_ / total;
+        m2_ += other.m2_ + delta * delta * count_ * other.count_ / total;
+        count_ += other.count_;
+        min_ = other.min_ < min_ ? other.min_ : min_;
+        max_ = other.max_ > max_ ? other.max_ : max_;
+    }
+
+    /**
+     * @brief Forget all values
+     */
+    void reset() {
+        *this = RunningStats();
+    }
+
+    /// Number of values
+    uint32_t count() const {
+        return count_;
+    }
+
+    /// Arithmetic mean, 0 without values
+    double mean() const {
+        return mean_;
+    }
+
+    /// Smallest value, 0 without values
+    double min() const {
+        return min_;
+    }
+
+    /// Largest value, 0 without values
+    double max() const {
+        return max_;
+    }
+
+    /// Sample variance (n - 1 in the denominator), 0 for fewer than two values
+    double variance() const {
+        return count_ > 1 ? m2_ / (count_ - 1) : 0.0;
+    }
+
+    /// Sample standard deviation
+    double stddev() const {
+        return std::sqrt(variance());
+    }
+
+private:
+    uint32_t count_ = 0;  ///< Number of values
+    double mean_ = 0.0;   ///< Running mean
+    double m2_ = 0.0;     ///< Sum of squared deviations from the mean
+    double min_ = 0.0;    ///< Smallest value
+    double max_ = 0.0;    ///< Largest value
+};
@@ -0,0 +1,258 @@
+/**
+ * @file sensor_pipeline.h
+ * @brief Compile-time configured sample path between sampling and transmission
+ *
+ * This header ties the sample ring, the wake-up semaphore and the transmit
+ * stage (transmission policy or window aggregation) into one object whose
+ * size is fixed at compile time. Declared with static storage, the whole
+ * path from the sampling thread to the BatchingSender lives in .bss and
+ * shows up in the footprint report; nothing is allocated at run time.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "batching_sender.h"
+#include "sensor_handler.h"
+#include "spsc_ring.h"
+#include "transmit_policy.h"
+#include "window_aggregator.h"
+
+/**
+ * @brief Transmit stage that queues the samples a policy admits
+ *
+ * The policy is held by value, so admit() is resolved at compile time
+ * instead of through the TransmitPolicy vtable.
+ *
+ * @tparam Policy TransmitPolicy implementation, e.g. DeadbandPolicy
+ */
+template <typename Policy>
+class FilterStage {
+public:
+    /**
+     * @brief Constructor - construct the policy in place
+     *
+     * @param args Arguments of the Policy constructor
+     */
+    template <typename... Args>
+    explicit FilterStage(Args&&... args) : policy_(std::forward<Args>(args)...) {
+    }
+
+    /// Uptime (ms) at which poll() has work to do, INT64_MAX for none
+    int64_t deadline(const BatchingSender& sender) const {
+        return sender.deadline();
+    }
+
+    /// Pass one sample through the policy to the batch
+    SendResult process(const SensorData& sample, BatchingSender& sender) {
+        if (!policy_.admit(sample)) {
+            return SendResult::kOk;
+        }
+        return sender.add(sample);
+    }
+
+    /// Flush a partial batch whose latency budget is used up
+    SendResult poll(int64_t now, BatchingSender& sender) {
+        ARG_UNUSED(now);
+        return sender.poll();
+    }
+
+    /// Get the policy, e.g. for its admitted/suppressed counters
+    const Policy& policy() const {
+        return policy_;
+    }
+
+private:
+    Policy policy_;  ///< Transmission policy
+};
+
+/**
+ * @brief Transmit stage that sends window summaries instead of samples
+ *
+ * The output buffer for closed windows is part of the stage, so it is
+ * statically allocated with the pipeline instead of on the transmit
+ * thread's stack.
+ *
+ * @tparam Sensors Number of sensors
+ * @tparam Panes   Panes per window, 1 for tumbling windows
+ */
+template <size_t Sensors, size_t Panes>
+class AggregateStage {
+public:
+    using Aggregator = WindowAggregator<Sensors, Panes>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param window_ms Window length in ms
+     */
+    explicit AggregateStage(uint32_t window_ms) : aggregator_(window_ms) {
+    }
+
+    /// Uptime (ms) at which the current pane ends, INT64_MAX before the first sample
+    int64_t deadline(const BatchingSender& sender) const {
+        ARG_UNUSED(sender);
+        const uint64_t boundary = aggregator_.nextBoundary();
+        return boundary == UINT64_MAX ? INT64_MAX : static_cast<int64_t>(boundary);
+    }
+
+    /// Fold one sample into the window statistics, send windows it closed
+    SendResult process(const SensorData& sample, BatchingSender& sender) {
+        const size_t n = aggregator_.add(sample.sensor, sample.timestamp_us / 1000,
+                                         sample.temperature, sample.humidity, summaries_,
+                                         Aggregator::kMaxEmit);
+        return n > 0 ? sender.sendAggregates(summaries_, n) : SendResult::kOk;
+    }
+
+    /// Close windows on time even if no sample arrived
+    SendResult poll(int64_t now, BatchingSender& sender) {
+        const size_t n =
+            aggregator_.poll(static_cast<uint64_t>(now), summaries_, Aggregator::kMaxEmit);
+        return n > 0 ? sender.sendAggregates(summaries_, n) : SendResult::kOk;
+    }
+
+    /// Get the aggregator, e.g. for its window length
+    const Aggregator& aggregator() const {
+        return aggregator_;
+    }
+
+private:
+    Aggregator aggregator_;                           ///< Per-sensor window statistics
+    WireAggregate summaries_[Aggregator::kMaxEmit];  ///< Closed windows ready to send
+};
+
+/**
+ * @brief Sample path from the sampling thread to the BatchingSender
+ *
+ * The sampling thread push()es samples; the transmit thread wait()s for
+ * them, drain()s the ring through the stage into the BatchingSender and
+ * poll()s the stage for time-based work (partial batches, closed
+ * windows). The stage is chosen at compile time; it must provide
+ * deadline(), process() and poll() like FilterStage and AggregateStage.
+ *
+ * All storage is inside the object: sizeof(SensorPipeline) is the complete
+ * RAM cost of the path, so the pipeline should be declared static.
+ *
+ * Usage example:
+ * @code
+ * using Pipeline = SensorPipeline<1, 64, FilterStage<DeadbandPolicy>>;
+ * static Pipeline pipeline(10, 50, 60000);
+ *
+ * // Sampling thread
+ * pipeline.push(sample);
+ *
+ * // Transmit thread
+ * pipeline.wait(pipeline.deadline(sender));
+ * pipeline.drain(sender, [](const SensorData& sample) { ... });
+ * pipeline.poll(k_uptime_get(), sender);
+ * @endcode
+ *
+ * @tparam Sensors      Number of sensors
+ * @tparam RingCapacity Slots of the sample ring, a power of two
+ * @tparam Stage        Transmit stage, FilterStage or AggregateStage
+ */
+template <size_t Sensors, size_t RingCapacity, typename Stage>
+class SensorPipeline {
+    static_assert(Sensors > 0 && Sensors <= SensorProtocol::kMaxSensors, "Invalid sensor count");
+
+public:
+    using Ring = SpscRing<SensorData, RingCapacity>;
+
+    static constexpr size_t kSensorCount = Sensors;  ///< Number of sensors
+
+    /**
+     * @brief Constructor - construct the stage in place
+     *
+     * @param args Arguments of the Stage constructor
+     */
+    template <typename... Args>
+    explicit SensorPipeline(Args&&... args) : stage_(std::forward<Args>(args)...) {
+        k_sem_init(&ready_, 0, 1);
+    }
+
+    SensorPipeline(const SensorPipeline&) = delete;
+    SensorPipeline& operator=(const SensorPipeline&) = delete;
+
+    /**
+     * @brief Hand a sample to the transmit thread (sampling thread only)
+     *
+     * @return true if queued, false if the ring was full (counted in ring().drops())
+     */
+    bool push(const SensorData& sample) {
+        if (!ring_.push(sample)) {
+            return false;
+        }
+        k_sem_give(&ready_);
+        return true;
+    }
+
+    /**
+     * @brief Get the uptime (ms) at which poll() has work to do
+     *
+     * @return Deadline of the stage, INT64_MAX for none
+     */
+    int64_t deadline(const BatchingSender& sender) const {
+        return stage_.deadline(sender);
+    }
+
+    /**
+     * @brief Block until a sample arrives or the uptime reaches wake
+     *
+     * @param wake Uptime (ms) to wake up at, INT64_MAX to wait for samples only
+     */
+    void wait(int64_t wake) {
+        k_sem_take(&ready_, wake == INT64_MAX ? K_FOREVER : K_TIMEOUT_ABS_MS(wake));
+    }
+
+    /**
+     * @brief Pass all queued samples through the stage (transmit thread only)
+     *
+     * @param sender  Batching layer in front of the UDP client
+     * @param observe Called as observe(sample) for every sample before the stage
+     *
+     * @return SendResult::kError if any transmission failed, otherwise kOk
+     *         (refused datagrams are counted by the sender)
+     */
+    template <typename Observer>
+    SendResult drain(BatchingSender& sender, Observer&& observe) {
+        SendResult result = SendResult::kOk;
+        SensorData sample;
+        while (ring_.pop(sample)) {
+            observe(sample);
+            if (stage_.process(sample, sender) == SendResult::kError) {
+                result = SendResult::kError;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Run the time-based work of the stage
+     *
+     * @param now    Current uptime in ms
+     * @param sender Batching layer in front of the UDP client
+     */
+    SendResult poll(int64_t now, BatchingSender& sender) {
+        return stage_.poll(now, sender);
+    }
+
+    /// Get the sample ring, e.g. for its drop counter and high-water mark
+    const Ring& ring() const {
+        return ring_;
+    }
+
+    /// Get the transmit stage
+    const Stage& stage() const {
+        return stage_;
+    }
+
+private:
+    Ring ring_;           ///< Lock-free hand-over between the threads
+    struct k_sem ready_;  ///< Given for every queued sample
+    Stage stage_;         ///< Transmission policy or window aggregation
+};
@@ -0,0 +1,137 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * This header provides a fixed-capacity ring buffer that decouples one
+ * producer thread from one consumer thread without locks. It is used to
+ * hand sensor samples from the sampling thread to the transmit thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fixed-capacity lock-free SPSC ring buffer
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may
+ * call pop(). The producer owns the head index and the consumer owns the
+ * tail index; each side only reads the other's index, so no locking is
+ * required. Indices run freely and are masked on access, which is why the
+ * capacity must be a power of two.
+ *
+ * When the ring is full, push() drops the new element and increments the
+ * drop counter instead of blocking the producer.
+ *
+ * Usage example:
+ * @code
+ * static SpscRing<SensorData, 64> ring;
+ *
+ * // Producer thread
+ * ring.push(sample);
+ *
+ * // Consumer thread
+ * SensorData sample;
+ * while (ring.pop(sample)) {
+ *     process(sample);
+ * }
+ * @endcode
+ *
+ * @tparam T        Element type (trivially copyable)
+ * @tparam Capacity Number of slots, must be a power of two
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2, "SpscRing capacity must be at least 2");
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append an element (producer side)
+     *
+     * @param item Element to copy into the ring
+     *
+     * @return true if the element was stored
+     * @return false if the ring was full and the element was dropped
+     */
+    bool push(const T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t used = head - tail;
+
+        if (used >= Capacity) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer_[head & kMask] = item;
+        head_.store(head + 1, std::memory_order_release);
+
+        if (used + 1 > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(static_cast<uint32_t>(used + 1), std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer side)
+     *
+     * @param item Receives the removed element
+     *
+     * @return true if an element was removed
+     * @return false if the ring was empty
+     */
+    bool pop(T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+
+        if (tail == head) {
+            return false;
+        }
+
+        item = buffer_[tail & kMask];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of elements currently stored
+     *
+     * @note The value is a snapshot and may be stale when read concurrently
+     */
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the total capacity of the ring
+     */
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+    /**
+     * @brief Get the number of elements dropped because the ring was full
+     */
+    uint32_t drops() const {
+        return drops_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the highest fill level observed since start-up
+     */
+    uint32_t highWater() const {
+        return high_water_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    T buffer_[Capacity]{};                        ///< Element storage
+    alignas(32) std::atomic<size_t> head_{0};     ///< Next write index (producer owned)
+    alignas(32) std::atomic<size_t> tail_{0};     ///< Next read index (consumer owned)
+    std::atomic<uint32_t> drops_{0};              ///< Elements rejected because the ring was full
+    std::atomic<uint32_t> high_water_{0};         ///< Maximum observed fill level
+};
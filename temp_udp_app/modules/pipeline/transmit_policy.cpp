@@ -0,0 +1,53 @@
+/**
+ * @file transmit_policy.cpp
+ * @brief Implementation of the report-on-change transmission policy
+ */
+
+#include "transmit_policy.h"
+
+/**
+ * @brief Constructor
+ */
+DeadbandPolicy::DeadbandPolicy(uint16_t temperature_deadband, uint16_t humidity_deadband,
+                               uint32_t heartbeat_ms)
+    : temperature_deadband_(temperature_deadband),
+      humidity_deadband_(humidity_deadband),
+      heartbeat_ms_(heartbeat_ms) {
+}
+
+/**
+ * @brief Transmit on a change beyond the deadband or when the heartbeat is due
+ *
+ * The reference is only moved by transmitted samples, so a slow drift is
+ * reported once it accumulates to the deadband.
+ *
+ * @return true if the sample should be transmitted
+ */
+bool DeadbandPolicy::decide(const SensorData& sample) {
+    if (sample.sensor >= SensorProtocol::kMaxSensors) {
+        return true;
+    }
+
+    Reference& ref = references_[sample.sensor];
+    const int16_t temperature = SensorProtocol::toCentiCelsius(sample.temperature);
+    const uint16_t humidity = SensorProtocol::toCentiPercent(sample.humidity);
+
+    if (ref.valid) {
+        const int32_t dt = temperature - ref.temperature;
+        const int32_t dh = humidity - ref.humidity;
+        const bool changed = (dt < 0 ? -dt : dt) >= temperature_deadband_ ||
+                             (dh < 0 ? -dh : dh) >= humidity_deadband_;
+        const bool heartbeat =
+            sample.timestamp_us - ref.timestamp_us >= uint64_t{heartbeat_ms_} * USEC_PER_MSEC;
+
+        if (!changed && !heartbeat) {
+            return false;
+        }
+    }
+
+    ref.valid = true;
+    ref.temperature = temperature;
+    ref.humidity = humidity;
+    ref.timestamp_us = sample.timestamp_us;
+    return true;
+}
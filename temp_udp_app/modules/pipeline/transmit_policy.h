@@ -0,0 +1,130 @@
+/**
+ * @file transmit_policy.h
+ * @brief Pluggable decision whether a sample is worth transmitting
+ *
+ * This header provides the interface the transmit thread consults for
+ * every sample before it is queued for UDP transmission, plus two
+ * policies: send everything, and report-on-change with a heartbeat.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "sensor_handler.h"
+#include "sensor_protocol.h"
+
+/**
+ * @brief Base class of all transmission policies
+ *
+ * Callers use admit(); implementations override decide(). The base class
+ * counts admitted and suppressed samples so that every policy reports its
+ * effect the same way.
+ *
+ * Usage example:
+ * @code
+ * DeadbandPolicy deadband(10, 50, 60000);
+ * TransmitPolicy& policy = deadband;
+ *
+ * if (policy.admit(sample)) {
+ *     sender.add(sample);
+ * }
+ * @endcode
+ */
+class TransmitPolicy {
+public:
+    virtual ~TransmitPolicy() = default;
+
+    /**
+     * @brief Decide whether a sample is transmitted and count the decision
+     *
+     * @param sample Sample in capture order per sensor
+     *
+     * @return true if the sample should be transmitted
+     */
+    bool admit(const SensorData& sample) {
+        const bool send = decide(sample);
+        if (send) {
+            admitted_++;
+        } else {
+            suppressed_++;
+        }
+        return send;
+    }
+
+    /// Number of samples admitted for transmission
+    uint32_t admitted() const {
+        return admitted_;
+    }
+
+    /// Number of samples suppressed by the policy
+    uint32_t suppressed() const {
+        return suppressed_;
+    }
+
+protected:
+    /**
+     * @brief Policy specific decision
+     *
+     * @return true if the sample should be transmitted
+     */
+    virtual bool decide(const SensorData& sample) = 0;
+
+private:
+    uint32_t admitted_ = 0;    ///< Samples admitted for transmission
+    uint32_t suppressed_ = 0;  ///< Samples suppressed
+};
+
+/**
+ * @brief Transmits every sample (previous behavior)
+ */
+class SendAlwaysPolicy : public TransmitPolicy {
+protected:
+    bool decide(const SensorData&) override {
+        return true;
+    }
+};
+
+/**
+ * @brief Report-on-change with deadband and heartbeat
+ *
+ * A sample is transmitted if its temperature or humidity differs from the
+ * last transmitted sample of the same sensor by at least the deadband, or
+ * if the last transmission of that sensor is at least heartbeat_ms old.
+ * The first sample of every sensor is always transmitted. Values are
+ * compared in the 0.01 unit fixed-point representation of the wire
+ * protocol, so the deadband refers exactly to what the collector received.
+ *
+ * On a stable site (changes below the deadband) the packet volume drops
+ * to one sample per sensor and heartbeat, while every real change is
+ * still reported with the sampling latency.
+ */
+class DeadbandPolicy : public TransmitPolicy {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param temperature_deadband Temperature change in 0.01 degrees Celsius
+     * @param humidity_deadband    Humidity change in 0.01 %RH
+     * @param heartbeat_ms         Longest time without a transmission per sensor
+     */
+    DeadbandPolicy(uint16_t temperature_deadband, uint16_t humidity_deadband,
+                   uint32_t heartbeat_ms);
+
+protected:
+    bool decide(const SensorData& sample) override;
+
+private:
+    /// Last transmitted sample of one sensor
+    struct Reference {
+        bool valid;            ///< A sample of this sensor was transmitted
+        int16_t temperature;   ///< Temperature in 0.01 degrees Celsius
+        uint16_t humidity;     ///< Humidity in 0.01 %RH
+        uint64_t timestamp_us; ///< Capture time in us since boot
+    };
+
+    uint16_t temperature_deadband_;  ///< Temperature deadband in 0.01 degrees Celsius
+    uint16_t humidity_deadband_;     ///< Humidity deadband in 0.01 %RH
+    uint32_t heartbeat_ms_;          ///< Heartbeat interval
+    Reference references_[SensorProtocol::kMaxSensors]{};  ///< Per-sensor reference
+};
@@ -0,0 +1,202 @@
+/**
+ * @file window_aggregator.h
+ * @brief Tumbling and sliding window summaries of sensor samples
+ *
+ * This header provides the aggregation stage between sampling and
+ * transmission: samples are folded into per-sensor running statistics and
+ * one WireAggregate record per sensor and window is emitted. Like the
+ * protocol it has no Zephyr dependencies.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "running_stats.h"
+#include "sensor_protocol.h"
+
+/**
+ * @brief Per-sensor window statistics with constant memory
+ *
+ * A window of window_ms is split into Panes panes of window_ms / Panes.
+ * Each pane holds RunningStats for temperature and humidity per sensor, so
+ * memory is Sensors x Panes x 2 statistics regardless of the sample rate.
+ *
+ * - Panes == 1: tumbling windows. One record per sensor every window_ms.
+ * - Panes > 1: sliding (hopping) windows. At every pane boundary the last
+ *   Panes panes are merged and one record covering the full window is
+ *   emitted, i.e. a record every window_ms / Panes.
+ *
+ * Window boundaries are aligned to multiples of the pane length on the
+ * sample time axis (ms since boot). A window is closed by the first sample
+ * or poll() at or after its end. Samples older than the current pane are
+ * counted in the current pane. Windows without samples produce no records,
+ * and after a gap longer than a window the aggregator resynchronizes
+ * without emitting empty windows.
+ *
+ * Usage example:
+ * @code
+ * static WindowAggregator<1, 1> aggregator(10000);  // 10 s tumbling window
+ * WireAggregate out[decltype(aggregator)::kMaxEmit];
+ *
+ * size_t n = aggregator.add(0, timestamp_ms, 23.4f, 51.2f, out, sizeof(out) / sizeof(out[0]));
+ * n += aggregator.poll(now_ms, out + n, ...);
+ * @endcode
+ *
+ * @tparam Sensors Number of sensors (sensor indices 0 to Sensors - 1)
+ * @tparam Panes   Panes per window, 1 for tumbling windows
+ */
+template <size_t Sensors, size_t Panes>
+class WindowAggregator {
+    static_assert(Sensors > 0 && Sensors <= SensorProtocol::kMaxSensors, "Invalid sensor count");
+    static_assert(Panes > 0, "At least one pane per window is required");
+
+public:
+    /// Upper bound of records emitted by a single add() or poll() call
+    static constexpr size_t kMaxEmit = Sensors * Panes;
+
+    /**
+     * @brief Constructor
+     *
+     * @param window_ms Window length in ms, rounded down to a multiple of Panes
+     */
+    explicit WindowAggregator(uint32_t window_ms)
+        : pane_ms_(window_ms / Panes > 0 ? window_ms / Panes : 1) {
+    }
+
+    /**
+     * @brief Fold one sample into the current pane
+     *
+     * Closes all windows that ended before @p timestamp first.
+     *
+     * @param sensor      Sensor index
+     * @param timestamp   Sample time in ms since boot
+     * @param temperature Temperature in degrees Celsius
+     * @param humidity    Relative humidity in %
+     * @param out         Receives the records of closed windows
+     * @param capacity    Capacity of @p out, at least kMaxEmit
+     *
+     * @return Number of records written to @p out
+     */
+    size_t add(uint8_t sensor, uint64_t timestamp, float temperature, float humidity,
+               WireAggregate* out, size_t capacity) {
+        const size_t emitted = advance(timestamp / pane_ms_, out, capacity);
+        if (sensor < Sensors) {
+            Pane& pane = panes_[sensor][current_ % Panes];
+            pane.temperature.add(temperature);
+            pane.humidity.add(humidity);
+        }
+        return emitted;
+    }
+
+    /**
+     * @brief Close all windows that ended before @p now
+     *
+     * Lets windows close on time when no further samples arrive.
+     *
+     * @return Number of records written to @p out
+     */
+    size_t poll(uint64_t now, WireAggregate* out, size_t capacity) {
+        return started_ ? advance(now / pane_ms_, out, capacity) : 0;
+    }
+
+    /**
+     * @brief Time at which the current pane ends (ms since boot)
+     *
+     * @return UINT64_MAX before the first sample
+     */
+    uint64_t nextBoundary() const {
+        return started_ ? (current_ + 1) * pane_ms_ : UINT64_MAX;
+    }
+
+    /// Window length in ms
+    uint32_t windowMs() const {
+        return pane_ms_ * Panes;
+    }
+
+private:
+    /// Statistics of one sensor within one pane
+    struct Pane {
+        RunningStats temperature;
+        RunningStats humidity;
+    };
+
+    /// Move the current pane to @p pane_index, emitting every window that ends on the way
+    size_t advance(uint64_t pane_index, WireAggregate* out, size_t capacity) {
+        if (!started_) {
+            current_ = pane_index;
+            started_ = true;
+            return 0;
+        }
+
+        size_t emitted = 0;
+        while (current_ < pane_index) {
+            emitted += emit(current_, out + emitted, capacity - emitted);
+            current_++;
+
+            // The pane slot is reused for the new pane
+            bool pending = false;
+            for (size_t s = 0; s < Sensors; ++s) {
+                panes_[s][current_ % Panes] = Pane{};
+                for (size_t p = 0; p < Panes; ++p) {
+                    pending = pending || panes_[s][p].temperature.count() > 0;
+                }
+            }
+
+            // Nothing left that a later window could contain: skip the gap
+            if (!pending) {
+                current_ = pane_index;
+            }
+        }
+        return emitted;
+    }
+
+    /// Emit one record per sensor for the window ending with pane @p last
+    size_t emit(uint64_t last, WireAggregate* out, size_t capacity) {
+        size_t emitted = 0;
+        const uint64_t first = last + 1 >= Panes ? last + 1 - Panes : 0;
+
+        for (size_t s = 0; s < Sensors && emitted < capacity; ++s) {
+            Pane window;
+            for (size_t p = 0; p < Panes; ++p) {
+                window.temperature.merge(panes_[s][p].temperature);
+                window.humidity.merge(panes_[s][p].humidity);
+            }
+            if (window.temperature.count() == 0) {
+                continue;
+            }
+
+            WireAggregate& a = out[emitted++];
+            a.sensor = static_cast<uint8_t>(s);
+            a.start = first * pane_ms_;
+            a.duration = static_cast<uint32_t>((last + 1 - first) * pane_ms_);
+            a.count = static_cast<uint16_t>(
+                window.temperature.count() < UINT16_MAX ? window.temperature.count() : UINT16_MAX);
+            a.temperature_min = centiCelsius(window.temperature.min());
+            a.temperature_max = centiCelsius(window.temperature.max());
+            a.temperature_mean = centiCelsius(window.temperature.mean());
+            a.temperature_stddev = centiPercent(window.temperature.stddev());
+            a.humidity_min = centiPercent(window.humidity.min());
+            a.humidity_max = centiPercent(window.humidity.max());
+            a.humidity_mean = centiPercent(window.humidity.mean());
+            a.humidity_stddev = centiPercent(window.humidity.stddev());
+        }
+        return emitted;
+    }
+
+    /// Round a statistic to 0.01 degree fixed-point
+    static int16_t centiCelsius(double value) {
+        return SensorProtocol::toCentiCelsius(static_cast<float>(value));
+    }
+
+    /// Round a statistic to 0.01 % fixed-point (also used for standard deviations)
+    static uint16_t centiPercent(double value) {
+        return SensorProtocol::toCentiPercent(static_cast<float>(value));
+    }
+
+    uint32_t pane_ms_;                ///< Pane length in ms
+    uint64_t current_ = 0;            ///< Index of the pane samples are added to
+    bool started_ = false;            ///< current_ is valid
+    Pane panes_[Sensors][Panes]{};    ///< Ring of panes per sensor
+};
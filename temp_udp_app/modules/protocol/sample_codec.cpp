@@ -0,0 +1,180 @@
+/**
+ * @file sample_codec.cpp
+ * @brief Implementation of the delta / delta-of-delta sample codec
+ *
+ * This file implements compression and decompression of WireSample
+ * batches using zigzag mapped LEB128 varints.
+ */
+
+#include "sample_codec.h"
+
+namespace {
+
+/**
+ * @brief Predictor state of one sensor series
+ */
+struct SeriesState {
+    bool seen;           ///< At least one sample of this sensor was coded
+    int64_t timestamp;   ///< Timestamp of the previous sample
+    int64_t delta;       ///< Timestamp delta between the previous two samples
+    int64_t temperature; ///< Previous temperature
+    int64_t humidity;    ///< Previous humidity
+};
+
+/**
+ * @brief Append a LEB128 varint
+ *
+ * @return Pointer behind the written bytes, nullptr if @p end was reached
+ */
+uint8_t* putVarint(uint8_t* p, const uint8_t* end, uint64_t v) {
+    while (p != nullptr && p < end) {
+        if (v < 0x80) {
+            *p++ = static_cast<uint8_t>(v);
+            return p;
+        }
+        *p++ = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Read a LEB128 varint
+ *
+ * @return Pointer behind the consumed bytes, nullptr on truncated or overlong input
+ */
+const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 64 && p != nullptr && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/// Largest zigzag code of a difference between two 16-bit values (+65535)
+constexpr uint64_t kMaxValueCode = 2 * static_cast<uint64_t>(UINT16_MAX);
+
+/**
+ * @brief Add with two's complement wrap-around instead of overflow
+ *
+ * The decoder runs on untrusted input; a wrapped timestamp is caught by the
+ * range check afterwards, a signed overflow would be undefined behavior.
+ */
+int64_t addWrapping(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+}  // namespace
+
+/**
+ * @brief Compress a batch of samples
+ *
+ * @return Number of bytes written, 0 on error
+ */
+size_t SampleCodec::encode(const WireSample* samples, size_t count, uint8_t* out,
+                           size_t capacity) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint8_t* end = out + capacity;
+    const int64_t base = static_cast<int64_t>(samples[0].timestamp_us);
+    SeriesState series[SensorProtocol::kMaxSensors] = {};
+    uint32_t previous_sequence = samples[0].sequence - 1;
+    uint8_t* p = out;
+
+    for (size_t i = 0; i < count && p != nullptr; ++i) {
+        const WireSample& s = samples[i];
+        if (s.sensor >= SensorProtocol::kMaxSensors) {
+            return 0;
+        }
+        SeriesState& st = series[s.sensor];
+        const int64_t ts = static_cast<int64_t>(s.timestamp_us);
+
+        p = putVarint(p, end, s.sensor);
+
+        // Sequence: gap to the previous sample of the batch, 0 if consecutive
+        p = putVarint(p, end, zigzag(static_cast<int32_t>(s.sequence - previous_sequence - 1)));
+        previous_sequence = s.sequence;
+
+        // Timestamp: offset to base for the first sample, then delta-of-delta
+        if (!st.seen) {
+            p = putVarint(p, end, zigzag(ts - base));
+        } else {
+            const int64_t delta = ts - st.timestamp;
+            p = putVarint(p, end, zigzag(delta - st.delta));
+            st.delta = delta;
+        }
+        st.timestamp = ts;
+
+        // Values: absolute for the first sample, then plain delta
+        p = putVarint(p, end, zigzag(s.temperature - st.temperature));
+        p = putVarint(p, end, zigzag(s.humidity - st.humidity));
+        st.temperature = s.temperature;
+        st.humidity = s.humidity;
+        st.seen = true;
+    }
+
+    return p != nullptr ? static_cast<size_t>(p - out) : 0;
+}
+
+/**
+ * @brief Decompress a batch of samples
+ *
+ * @return true if exactly @p count samples were decoded and the payload
+ *         was consumed completely
+ */
+bool SampleCodec::decode(const uint8_t* data, size_t len, uint64_t base_timestamp,
+                         uint32_t base_sequence, WireSample* samples, size_t count) {
+    const uint8_t* end = data + len;
+    const uint8_t* p = data;
+    const int64_t base = static_cast<int64_t>(base_timestamp);
+    SeriesState series[SensorProtocol::kMaxSensors] = {};
+    uint32_t sequence = base_sequence - 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t sensor, seq_code, ts_code, temp_code, hum_code;
+
+        p = getVarint(p, end, sensor);
+        if (p == nullptr || sensor >= SensorProtocol::kMaxSensors) {
+            return false;
+        }
+        p = getVarint(p, end, seq_code);
+        p = getVarint(p, end, ts_code);
+        p = getVarint(p, end, temp_code);
+        p = getVarint(p, end, hum_code);
+        if (p == nullptr || temp_code > kMaxValueCode || hum_code > kMaxValueCode) {
+            return false;
+        }
+
+        SeriesState& st = series[sensor];
+        if (!st.seen) {
+            st.timestamp = addWrapping(base, unzigzag(ts_code));
+        } else {
+            st.delta = addWrapping(st.delta, unzigzag(ts_code));
+            st.timestamp = addWrapping(st.timestamp, st.delta);
+        }
+        st.temperature += unzigzag(temp_code);
+        st.humidity += unzigzag(hum_code);
+        st.seen = true;
+
+        if (st.temperature < INT16_MIN || st.temperature > INT16_MAX || st.humidity < 0 ||
+            st.humidity > UINT16_MAX || st.timestamp < 0) {
+            return false;
+        }
+
+        sequence += static_cast<uint32_t>(unzigzag(seq_code)) + 1;
+
+        samples[i].sensor = static_cast<uint8_t>(sensor);
+        samples[i].sequence = sequence;
+        samples[i].timestamp_us = static_cast<uint64_t>(st.timestamp);
+        samples[i].temperature = static_cast<int16_t>(st.temperature);
+        samples[i].humidity = static_cast<uint16_t>(st.humidity);
+    }
+
+    return p == end;
+}
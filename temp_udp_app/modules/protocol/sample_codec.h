@@ -0,0 +1,103 @@
+/**
+ * @file sample_codec.h
+ * @brief Time-series compression for batches of fixed-point sensor samples
+ *
+ * This header provides a lossless codec for WireSample batches. It exploits
+ * the fact that SHT31 readings change very slowly between consecutive
+ * samples and that samples are taken at a (nearly) constant interval.
+ * Like the wire protocol it has no Zephyr dependencies and is shared by the
+ * firmware encoder and host-side decoders.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sensor_protocol.h"
+
+/**
+ * @brief Delta / delta-of-delta + zigzag varint codec for sample batches
+ *
+ * Each sample is encoded as five variable-length integers:
+ * - sensor: the sensor index on the device.
+ * - sequence: gap to the previous sample of the batch (any sensor) minus
+ *   one, so consecutive samples encode as 0. The first sample is relative
+ *   to the datagram base sequence.
+ * - timestamp: delta-of-delta to the previous two samples of the same
+ *   sensor (the first sample of a sensor stores its offset to the datagram
+ *   base timestamp, the second one a plain delta). A constant sampling
+ *   interval encodes as 0.
+ * - temperature and humidity: delta to the previous sample of the same
+ *   sensor (the first sample stores the absolute value). Plain deltas are
+ *   used for values because delta-of-delta would double the sensor noise.
+ *
+ * The predictor state is kept per sensor, so interleaved samples of
+ * several sensors compress as well as a single series.
+ *
+ * Signed values are zigzag mapped (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+ * and written as LEB128 varints, so every value in -64..63 takes a single
+ * byte. Timestamps are in microseconds, so the scheduling jitter of a few
+ * ticks takes a second byte: a steady series compresses to 5 to 6 bytes
+ * per sample instead of SensorProtocol::kSampleSize (11 bytes).
+ *
+ * Usage example:
+ * @code
+ * uint8_t buf[SampleCodec::maxEncodedSize(n)];
+ * size_t len = SampleCodec::encode(samples, n, buf, sizeof(buf));
+ *
+ * WireSample decoded[n];
+ * SampleCodec::decode(buf, len, samples[0].timestamp_us, samples[0].sequence, decoded, n);
+ * @endcode
+ */
+class SampleCodec {
+public:
+    /// Worst-case encoded size of one sample (sensor byte plus four 64-bit varints)
+    static constexpr size_t kMaxSampleSize = 1 + 4 * 10;
+
+    /**
+     * @brief Get the worst-case encoded size for a number of samples
+     */
+    static constexpr size_t maxEncodedSize(size_t count) {
+        return count * kMaxSampleSize;
+    }
+
+    /**
+     * @brief Compress a batch of samples
+     *
+     * @param samples  Samples in capture order
+     * @param count    Number of samples
+     * @param out      Output buffer
+     * @param capacity Size of the output buffer in bytes
+     *
+     * @return Number of bytes written, 0 if the output buffer is too small or
+     *         a sensor index is not below SensorProtocol::kMaxSensors
+     */
+    static size_t encode(const WireSample* samples, size_t count, uint8_t* out, size_t capacity);
+
+    /**
+     * @brief Decompress a batch of samples
+     *
+     * @param data           Compressed payload
+     * @param len            Payload length in bytes
+     * @param base_timestamp Timestamp of the first sample
+     * @param base_sequence  Sequence number of the first sample
+     * @param samples        Receives the decoded samples
+     * @param count          Number of samples to decode
+     *
+     * @return true if exactly @p count samples were decoded and the
+     *         payload was consumed completely
+     */
+    static bool decode(const uint8_t* data, size_t len, uint64_t base_timestamp,
+                       uint32_t base_sequence, WireSample* samples, size_t count);
+
+    /// Map a signed value to an unsigned one with small magnitude for small values
+    static inline uint64_t zigzag(int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    /// Inverse of zigzag()
+    static inline int64_t unzigzag(uint64_t v) {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+};
@@ -0,0 +1,277 @@
+/**
+ * @file sensor_protocol.cpp
+ * @brief Implementation of the sensor sample wire protocol
+ *
+ * This file implements encoding and decoding of sensor sample datagrams.
+ * Every field is written explicitly in network byte order, so the result
+ * does not depend on struct layout, padding or host endianness.
+ */
+
+#include "sensor_protocol.h"
+
+#include "sample_codec.h"
+
+/**
+ * @brief Encode a datagram
+ *
+ * @return Number of bytes written, 0 on error
+ */
+size_t SensorProtocol::encode(const WirePacketHeader& header, const WireSample* samples,
+                              size_t count, uint8_t* out, size_t capacity) {
+    const size_t len = encodedSize(count);
+    if (count == 0 || count > kMaxSamples || len > capacity) {
+        return 0;
+    }
+
+    // Sensors of one cycle finish in any order, so the first sample need not
+    // be the earliest; deltas from the earliest are never negative
+    uint64_t base = samples[0].timestamp_us;
+    for (size_t i = 1; i < count; ++i) {
+        if (samples[i].timestamp_us < base) {
+            base = samples[i].timestamp_us;
+        }
+    }
+    const uint32_t base_sequence = samples[0].sequence;
+
+    uint8_t* p = putHeader(out, header, kPacketSamples, count, base_sequence, base);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t delta = samples[i].timestamp_us - base;
+        const uint32_t sequence_delta = samples[i].sequence - base_sequence;
+        if (delta > UINT32_MAX ||
+            sequence_delta > UINT16_MAX || samples[i].sensor >= kMaxSensors) {
+            return 0;
+        }
+
+        p = put16(p, static_cast<uint16_t>(samples[i].temperature));
+        p = put16(p, samples[i].humidity);
+        p = put32(p, static_cast<uint32_t>(delta));
+        *p++ = samples[i].sensor;
+        p = put16(p, static_cast<uint16_t>(sequence_delta));
+    }
+
+    return len;
+}
+
+/**
+ * @brief Encode a datagram with a compressed payload
+ *
+ * @return Number of bytes written, 0 on error or if it does not fit
+ */
+size_t SensorProtocol::encodeCompressed(const WirePacketHeader& header,
+                                        const WireSample* samples, size_t count, uint8_t* out,
+                                        size_t capacity) {
+    if (count == 0 || count > kMaxSamples || capacity <= kHeaderSize) {
+        return 0;
+    }
+
+    const size_t payload = SampleCodec::encode(samples, count, out + kHeaderSize,
+                                               capacity - kHeaderSize);
+    if (payload == 0) {
+        return 0;
+    }
+
+    putHeader(out, header, kPacketSamplesCompressed, count, samples[0].sequence,
+              samples[0].timestamp_us);
+    return kHeaderSize + payload;
+}
+
+/**
+ * @brief Encode a datagram of window summaries
+ *
+ * @return Number of bytes written, 0 on error
+ */
+size_t SensorProtocol::encodeAggregates(const WirePacketHeader& header,
+                                        const WireAggregate* aggregates, size_t count,
+                                        uint8_t* out, size_t capacity) {
+    const size_t len = aggregateEncodedSize(count);
+    if (count == 0 || count > kMaxSamples || len > capacity) {
+        return 0;
+    }
+
+    const uint64_t base = aggregates[0].start;
+
+    // Summaries are in ms; the header carries the base in us like all datagrams
+    uint8_t* p = putHeader(out, header, kPacketAggregates, count, 0, base * 1000);
+
+    for (size_t i = 0; i < count; ++i) {
+        const WireAggregate& a = aggregates[i];
+        const uint64_t delta = a.start - base;
+        if (a.start < base || delta > UINT32_MAX || a.sensor >= kMaxSensors) {
+            return 0;
+        }
+
+        *p++ = a.sensor;
+        p = put32(p, static_cast<uint32_t>(delta));
+        p = put32(p, a.duration);
+        p = put16(p, a.count);
+        p = put16(p, static_cast<uint16_t>(a.temperature_min));
+        p = put16(p, static_cast<uint16_t>(a.temperature_max));
+        p = put16(p, static_cast<uint16_t>(a.temperature_mean));
+        p = put16(p, a.temperature_stddev);
+        p = put16(p, a.humidity_min);
+        p = put16(p, a.humidity_max);
+        p = put16(p, a.humidity_mean);
+        p = put16(p, a.humidity_stddev);
+    }
+
+    return len;
+}
+
+/**
+ * @brief Write the common datagram header
+ *
+ * @return Pointer behind the header
+ */
+uint8_t* SensorProtocol::putHeader(uint8_t* p, const WirePacketHeader& header, uint8_t type,
+                                   size_t count, uint32_t base_sequence,
+                                   uint64_t base_timestamp) {
+    p = put16(p, kMagic);
+    *p++ = kProtocolVersion;
+    *p++ = type;
+    *p++ = header.flags;
+    *p++ = static_cast<uint8_t>(count);
+    p = put32(p, header.device_id);
+    p = put32(p, header.boot_id);
+    p = put32(p, header.sequence);
+    p = put32(p, base_sequence);
+    p = put64(p, base_timestamp);
+    return put64(p, static_cast<uint64_t>(header.clock_offset));
+}
+
+/**
+ * @brief Set flags in an already encoded datagram
+ *
+ * @return true if the datagram is long enough to carry a header
+ */
+bool SensorProtocol::setFlags(uint8_t* data, size_t len, uint8_t flags) {
+    if (len < kHeaderSize) {
+        return false;
+    }
+    data[kFlagsOffset] |= flags;
+    return true;
+}
+
+/**
+ * @brief Decode only the datagram header
+ *
+ * @return true if magic, version and length are valid
+ */
+bool SensorProtocol::decodeHeader(const uint8_t* data, size_t len, WirePacketHeader& header) {
+    if (len < kHeaderSize || get16(data) != kMagic) {
+        return false;
+    }
+
+    header.version = data[2];
+    header.type = data[3];
+    header.flags = data[kFlagsOffset];
+    header.count = data[5];
+    header.device_id = get32(data + 6);
+    header.boot_id = get32(data + 10);
+    header.sequence = get32(data + 14);
+    header.base_sequence = get32(data + 18);
+    header.base_timestamp = get64(data + 22);
+    header.clock_offset = static_cast<int64_t>(get64(data + 30));
+
+    return header.version == kProtocolVersion;
+}
+
+/**
+ * @brief Decode a complete datagram
+ *
+ * @return true if the datagram is well-formed and all samples fit
+ */
+bool SensorProtocol::decode(const uint8_t* data, size_t len, WirePacketHeader& header,
+                            WireSample* samples, size_t max_samples) {
+    if (!decodeHeader(data, len, header) || header.count > max_samples) {
+        return false;
+    }
+
+    if (header.type == kPacketSamplesCompressed) {
+        return SampleCodec::decode(data + kHeaderSize, len - kHeaderSize, header.base_timestamp,
+                                   header.base_sequence, samples, header.count);
+    }
+    if (header.type != kPacketSamples || len != encodedSize(header.count)) {
+        return false;
+    }
+
+    const uint8_t* p = data + kHeaderSize;
+    for (size_t i = 0; i < header.count; ++i, p += kSampleSize) {
+        samples[i].temperature = static_cast<int16_t>(get16(p));
+        samples[i].humidity = get16(p + 2);
+        samples[i].timestamp_us = header.base_timestamp + get32(p + 4);
+        samples[i].sensor = p[8];
+        samples[i].sequence = header.base_sequence + get16(p + 9);
+        if (samples[i].sensor >= kMaxSensors) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode a datagram of window summaries
+ *
+ * @return true if the datagram is well-formed and all summaries fit
+ */
+bool SensorProtocol::decodeAggregates(const uint8_t* data, size_t len, WirePacketHeader& header,
+                                      WireAggregate* aggregates, size_t max_aggregates) {
+    if (!decodeHeader(data, len, header) || header.type != kPacketAggregates ||
+        header.count > max_aggregates || len != aggregateEncodedSize(header.count)) {
+        return false;
+    }
+
+    const uint8_t* p = data + kHeaderSize;
+    for (size_t i = 0; i < header.count; ++i, p += kAggregateSize) {
+        WireAggregate& a = aggregates[i];
+        a.sensor = p[0];
+        a.start = header.base_timestamp / 1000 + get32(p + 1);
+        a.duration = get32(p + 5);
+        a.count = get16(p + 9);
+        a.temperature_min = static_cast<int16_t>(get16(p + 11));
+        a.temperature_max = static_cast<int16_t>(get16(p + 13));
+        a.temperature_mean = static_cast<int16_t>(get16(p + 15));
+        a.temperature_stddev = get16(p + 17);
+        a.humidity_min = get16(p + 19);
+        a.humidity_max = get16(p + 21);
+        a.humidity_mean = get16(p + 23);
+        a.humidity_stddev = get16(p + 25);
+        if (a.sensor >= kMaxSensors) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Convert degrees Celsius to 0.01 degree fixed-point
+ *
+ * Rounds to the nearest step and saturates to the int16 range
+ * (-327.68 to +327.67 degrees, far beyond the sensor range).
+ */
+int16_t SensorProtocol::toCentiCelsius(float celsius) {
+    const float scaled = celsius * 100.0f + (celsius >= 0.0f ? 0.5f : -0.5f);
+    if (scaled >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (scaled <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+/**
+ * @brief Convert relative humidity in % to 0.01 % fixed-point
+ *
+ * Rounds to the nearest step and saturates to 0..655.35 %.
+ */
+uint16_t SensorProtocol::toCentiPercent(float percent) {
+    const float scaled = percent * 100.0f + 0.5f;
+    if (scaled >= 65535.0f) {
+        return UINT16_MAX;
+    }
+    if (scaled <= 0.0f) {
+        return 0;
+    }
+    return static_cast<uint16_t>(scaled);
+}
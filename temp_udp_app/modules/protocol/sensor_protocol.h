@@ -0,0 +1,348 @@
+/**
+ * @file sensor_protocol.h
+ * @brief Versioned binary wire protocol for sensor sample datagrams
+ *
+ * This header defines the on-the-wire representation of sensor samples
+ * together with an encoder and a decoder. The protocol is independent of
+ * the in-memory SensorData layout and of the host architecture: all fields
+ * are fixed-point integers written byte by byte in network byte order
+ * (big-endian). The module has no Zephyr dependencies so that collectors
+ * and tools on the host can use the very same code.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Decoded datagram header
+ *
+ * Wire layout (big-endian, 38 bytes):
+ * @code
+ * Offset  Size  Field
+ *  0      2     magic            0x5348 ("SH")
+ *  2      1     version          kProtocolVersion
+ *  3      1     type             WirePacketType
+ *  4      1     flags            WirePacketFlags
+ *  5      1     count            number of samples following the header
+ *  6      4     device_id        sender identification
+ * 10      4     boot_id          random ID of the sender's current boot
+ * 14      4     sequence         datagram sequence number
+ * 18      4     base_sequence    sample sequence number of the first sample
+ * 22      8     base_timestamp   earliest sample timestamp in us since boot (see below)
+ * 30      8     clock_offset     int64, Unix time minus uptime in us (kFlagClockSynced)
+ * @endcode
+ *
+ * base_timestamp is the reference of the timestamp deltas: the earliest
+ * timestamp of the datagram for kPacketSamples, the first sample's for
+ * kPacketSamplesCompressed and the first window start for kPacketAggregates.
+ *
+ * The sequence numbers restart with every boot; boot_id tells the boots
+ * apart. Adding clock_offset to a sample timestamp gives its capture time
+ * in microseconds since the Unix epoch.
+ */
+struct WirePacketHeader {
+    uint8_t version;          ///< Protocol version of the datagram
+    uint8_t type;             ///< Payload type, see WirePacketType
+    uint8_t flags;            ///< Combination of WirePacketFlags
+    uint8_t count;            ///< Number of samples in the datagram
+    uint32_t device_id;       ///< Sender device identification
+    uint32_t boot_id;         ///< Random ID of the sender's boot
+    uint32_t sequence;        ///< Datagram sequence number
+    uint32_t base_sequence;   ///< Sequence number of the first sample (0 for summaries)
+    uint64_t base_timestamp;  ///< Reference of the timestamp deltas (us since boot)
+    int64_t clock_offset;     ///< Unix time minus uptime in us, 0 if not synced
+};
+
+/**
+ * @brief One decoded sample in fixed-point representation
+ *
+ * Wire layout (big-endian, 11 bytes):
+ * @code
+ * Offset  Size  Field
+ *  0      2     temperature      int16, 0.01 degrees Celsius
+ *  2      2     humidity         uint16, 0.01 %RH
+ *  4      4     timestamp delta  uint32, us relative to base_timestamp
+ *  8      1     sensor           sensor index on the device
+ *  9      2     sequence delta   uint16, relative to base_sequence
+ * @endcode
+ */
+struct WireSample {
+    int16_t temperature;    ///< Temperature in 0.01 degrees Celsius
+    uint16_t humidity;      ///< Relative humidity in 0.01 %
+    uint64_t timestamp_us;  ///< Absolute capture time in us since boot
+    uint32_t sequence;      ///< Per-boot sample sequence number
+    uint8_t sensor;         ///< Sensor index on the device (below kMaxSensors)
+};
+
+/**
+ * @brief Summary of one sensor over one aggregation window
+ *
+ * Wire layout (big-endian, 27 bytes):
+ * @code
+ * Offset  Size  Field
+ *  0      1     sensor           sensor index on the device
+ *  1      4     start delta      uint32, window start in ms relative to base_timestamp / 1000
+ *  5      4     duration         uint32, window length in ms
+ *  9      2     count            uint16, number of samples in the window
+ * 11      8     temperature      int16 min, max, mean, uint16 stddev (0.01 degrees Celsius)
+ * 19      8     humidity         uint16 min, max, mean, stddev (0.01 %RH)
+ * @endcode
+ */
+struct WireAggregate {
+    uint64_t start;               ///< Window start in ms since boot
+    uint32_t duration;            ///< Window length in ms
+    uint16_t count;               ///< Number of samples summarized
+    uint8_t sensor;               ///< Sensor index on the device (below kMaxSensors)
+    int16_t temperature_min;      ///< Lowest temperature in 0.01 degrees Celsius
+    int16_t temperature_max;      ///< Highest temperature in 0.01 degrees Celsius
+    int16_t temperature_mean;     ///< Mean temperature in 0.01 degrees Celsius
+    uint16_t temperature_stddev;  ///< Temperature standard deviation in 0.01 degrees Celsius
+    uint16_t humidity_min;        ///< Lowest relative humidity in 0.01 %
+    uint16_t humidity_max;        ///< Highest relative humidity in 0.01 %
+    uint16_t humidity_mean;       ///< Mean relative humidity in 0.01 %
+    uint16_t humidity_stddev;     ///< Relative humidity standard deviation in 0.01 %
+};
+
+/// Datagram payload types
+enum WirePacketType : uint8_t {
+    kPacketSamples = 1,            ///< Uncompressed fixed-point samples
+    kPacketSamplesCompressed = 2,  ///< Samples compressed with SampleCodec
+    kPacketAggregates = 3,         ///< Window summaries (WireAggregate)
+};
+
+/// Datagram header flags
+enum WirePacketFlags : uint8_t {
+    kFlagBackfill = 0x01,     ///< Replayed from the store-and-forward buffer after an outage
+    kFlagClockSynced = 0x02,  ///< clock_offset holds a valid SNTP offset
+};
+
+/**
+ * @brief Encoder and decoder for sensor sample datagrams
+ *
+ * Usage example:
+ * @code
+ * WirePacketHeader header{};
+ * header.device_id = 1;
+ * header.sequence = seq++;
+ *
+ * uint8_t buf[SensorProtocol::encodedSize(kMax)];
+ * size_t len = SensorProtocol::encode(header, samples, n, buf, sizeof(buf));
+ *
+ * // Receiver side
+ * WireSample decoded[SensorProtocol::kMaxSamples];
+ * if (SensorProtocol::decode(buf, len, header, decoded, SensorProtocol::kMaxSamples)) {
+ *     float temp = SensorProtocol::fromCentiCelsius(decoded[0].temperature);
+ * }
+ * @endcode
+ */
+class SensorProtocol {
+public:
+    static constexpr uint16_t kMagic = 0x5348;        ///< "SH"
+    static constexpr uint8_t kProtocolVersion = 3;    ///< Current wire format version
+    static constexpr size_t kHeaderSize = 38;         ///< Encoded header size in bytes
+    static constexpr size_t kSampleSize = 11;         ///< Encoded sample size in bytes
+    static constexpr size_t kAggregateSize = 27;      ///< Encoded aggregate size in bytes
+    static constexpr size_t kMaxSamples = 255;        ///< Limited by the 8-bit count field
+    static constexpr uint8_t kMaxSensors = 16;        ///< Sensors per device
+    static constexpr size_t kFlagsOffset = 4;         ///< Offset of the flags byte
+
+    /**
+     * @brief Get the encoded datagram size for a number of samples
+     */
+    static constexpr size_t encodedSize(size_t count) {
+        return kHeaderSize + count * kSampleSize;
+    }
+
+    /**
+     * @brief Get the encoded datagram size for a number of aggregates
+     */
+    static constexpr size_t aggregateEncodedSize(size_t count) {
+        return kHeaderSize + count * kAggregateSize;
+    }
+
+    /**
+     * @brief Encode a datagram
+     *
+     * The version, type and count fields of @p header are filled in by the
+     * encoder. base_timestamp is the earliest sample timestamp, so samples
+     * need not be in capture order (sensors of one cycle complete in any
+     * order); base_sequence is taken from the first sample.
+     *
+     * @param header   Header fields (device_id, boot_id, sequence, flags, clock_offset)
+     * @param samples  Samples to encode
+     * @param count    Number of samples (at most kMaxSamples)
+     * @param out      Output buffer
+     * @param capacity Size of the output buffer in bytes
+     *
+     * @return Number of bytes written, 0 if the buffer is too small, the
+     *         count is out of range, a timestamp or sequence delta does not
+     *         fit or a sensor index is not below kMaxSensors
+     */
+    static size_t encode(const WirePacketHeader& header, const WireSample* samples, size_t count,
+                         uint8_t* out, size_t capacity);
+
+    /**
+     * @brief Encode a datagram with a compressed payload
+     *
+     * Same header as encode() with type kPacketSamplesCompressed, followed
+     * by the SampleCodec representation of the samples instead of the
+     * fixed-size records.
+     *
+     * @param header   Header fields (device_id, boot_id, sequence, flags, clock_offset)
+     * @param samples  Samples to encode
+     * @param count    Number of samples (at most kMaxSamples)
+     * @param out      Output buffer
+     * @param capacity Size of the output buffer in bytes
+     *
+     * @return Number of bytes written, 0 if the count is out of range or the
+     *         compressed datagram does not fit into @p capacity. Passing
+     *         encodedSize(count) - 1 as capacity therefore only succeeds if
+     *         compression actually saves space.
+     */
+    static size_t encodeCompressed(const WirePacketHeader& header, const WireSample* samples,
+                                   size_t count, uint8_t* out, size_t capacity);
+
+    /**
+     * @brief Encode a datagram of window summaries
+     *
+     * Header as for encode() with type kPacketAggregates; base_timestamp is
+     * the start of the first window and base_sequence is 0.
+     *
+     * @param header     Header fields (device_id, boot_id, sequence, flags, clock_offset)
+     * @param aggregates Window summaries, ordered by window start
+     * @param count      Number of summaries (at most kMaxSamples)
+     * @param out        Output buffer
+     * @param capacity   Size of the output buffer in bytes
+     *
+     * @return Number of bytes written, 0 if the buffer is too small, the
+     *         count is out of range, a start delta does not fit or a
+     *         sensor index is not below kMaxSensors
+     */
+    static size_t encodeAggregates(const WirePacketHeader& header,
+                                   const WireAggregate* aggregates, size_t count, uint8_t* out,
+                                   size_t capacity);
+
+    /**
+     * @brief Decode a datagram of window summaries
+     *
+     * @param data           Received datagram
+     * @param len            Datagram length in bytes
+     * @param header         Receives the decoded header
+     * @param aggregates     Receives the decoded summaries with absolute start times
+     * @param max_aggregates Capacity of @p aggregates
+     *
+     * @return true if the datagram is a well-formed kPacketAggregates
+     *         datagram and all summaries fit
+     */
+    static bool decodeAggregates(const uint8_t* data, size_t len, WirePacketHeader& header,
+                                 WireAggregate* aggregates, size_t max_aggregates);
+
+    /**
+     * @brief Decode only the datagram header
+     *
+     * @param data   Received datagram
+     * @param len    Datagram length in bytes
+     * @param header Receives the decoded header
+     *
+     * @return true if magic, version and length are valid
+     */
+    static bool decodeHeader(const uint8_t* data, size_t len, WirePacketHeader& header);
+
+    /**
+     * @brief Decode a complete datagram
+     *
+     * @param data        Received datagram
+     * @param len         Datagram length in bytes
+     * @param header      Receives the decoded header
+     * @param samples     Receives the decoded samples with absolute timestamps
+     * @param max_samples Capacity of @p samples
+     *
+     * @return true if the datagram is well-formed and all samples fit
+     *
+     * @note Both plain and compressed sample datagrams are accepted;
+     *       kPacketAggregates datagrams need decodeAggregates()
+     */
+    static bool decode(const uint8_t* data, size_t len, WirePacketHeader& header,
+                       WireSample* samples, size_t max_samples);
+
+    /**
+     * @brief Set flags in an already encoded datagram
+     *
+     * Used to mark stored datagrams as backfill without re-encoding them.
+     *
+     * @param data  Encoded datagram
+     * @param len   Datagram length in bytes
+     * @param flags WirePacketFlags to set
+     *
+     * @return true if the datagram is long enough to carry a header
+     */
+    static bool setFlags(uint8_t* data, size_t len, uint8_t flags);
+
+    /**
+     * @brief Convert degrees Celsius to 0.01 degree fixed-point (rounded, saturated)
+     */
+    static int16_t toCentiCelsius(float celsius);
+
+    /**
+     * @brief Convert relative humidity in % to 0.01 % fixed-point (rounded, saturated)
+     */
+    static uint16_t toCentiPercent(float percent);
+
+    /**
+     * @brief Convert 0.01 degree fixed-point back to degrees Celsius
+     */
+    static inline float fromCentiCelsius(int16_t centi) {
+        return static_cast<float>(centi) / 100.0f;
+    }
+
+    /**
+     * @brief Convert 0.01 % fixed-point back to relative humidity in %
+     */
+    static inline float fromCentiPercent(uint16_t centi) {
+        return static_cast<float>(centi) / 100.0f;
+    }
+
+    /**
+     * @brief Write the common datagram header
+     *
+     * @return Pointer behind the header
+     */
+    static uint8_t* putHeader(uint8_t* p, const WirePacketHeader& header, uint8_t type,
+                              size_t count, uint32_t base_sequence, uint64_t base_timestamp);
+
+    /// Write a 16-bit value in network byte order
+    static inline uint8_t* put16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v);
+        return p + 2;
+    }
+
+    /// Write a 32-bit value in network byte order
+    static inline uint8_t* put32(uint8_t* p, uint32_t v) {
+        p = put16(p, static_cast<uint16_t>(v >> 16));
+        return put16(p, static_cast<uint16_t>(v));
+    }
+
+    /// Write a 64-bit value in network byte order
+    static inline uint8_t* put64(uint8_t* p, uint64_t v) {
+        p = put32(p, static_cast<uint32_t>(v >> 32));
+        return put32(p, static_cast<uint32_t>(v));
+    }
+
+    /// Read a 16-bit value in network byte order
+    static inline uint16_t get16(const uint8_t* p) {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    /// Read a 32-bit value in network byte order
+    static inline uint32_t get32(const uint8_t* p) {
+        return (static_cast<uint32_t>(get16(p)) << 16) | get16(p + 2);
+    }
+
+    /// Read a 64-bit value in network byte order
+    static inline uint64_t get64(const uint8_t* p) {
+        return (static_cast<uint64_t>(get32(p)) << 32) | get32(p + 4);
+    }
+};
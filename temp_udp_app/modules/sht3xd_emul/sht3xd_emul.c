@@ -0,0 +1,180 @@
+/**
+ * @file sht3xd_emul.c
+ * @brief Implementation of the SHT3x I2C emulator
+ *
+ * Every write of a measurement command (single-shot 0x24xx/0x2Cxx) or of
+ * the periodic fetch command (0xE000) latches a new reading; the next read
+ * returns it as temperature word, CRC, humidity word, CRC. All other
+ * commands (clear status, periodic start, alert limits) are accepted and
+ * ignored.
+ */
+
+#define DT_DRV_COMPAT sensirion_sht3xd
+
+#include "sht3xd_emul.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(sht3xd_emul, CONFIG_SENSOR_LOG_LEVEL);
+
+#define SHT3XD_CMD_FETCH 0xE000
+
+/* Runtime state of one emulated sensor */
+struct sht3xd_emul_data {
+    int16_t base_temperature;  /* 0.01 degC */
+    uint16_t base_humidity;    /* 0.01 %RH */
+    int16_t walk_temperature;  /* Offset from base, 0.01 degC */
+    int16_t walk_humidity;     /* Offset from base, 0.01 %RH */
+    uint32_t rng;              /* xorshift32 state */
+    uint32_t measurements;     /* Latched readings */
+    uint8_t frame[6];          /* Latest measurement frame */
+    bool frame_valid;          /* A frame is ready to be read */
+};
+
+/* CRC-8 as used by Sensirion: polynomial 0x31, init 0xFF */
+static uint8_t sht3xd_emul_crc(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0xFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t sht3xd_emul_rand(struct sht3xd_emul_data *data)
+{
+    uint32_t x = data->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data->rng = x;
+    return x;
+}
+
+/* Advance a bounded random walk by at most CONFIG_APP_SHT3XD_EMUL_WALK_STEP */
+static int16_t sht3xd_emul_walk(struct sht3xd_emul_data *data, int16_t offset)
+{
+    const int32_t span = 2 * CONFIG_APP_SHT3XD_EMUL_WALK_STEP + 1;
+    int32_t next = offset + (int32_t)(sht3xd_emul_rand(data) % span) -
+                   CONFIG_APP_SHT3XD_EMUL_WALK_STEP;
+
+    return (int16_t)CLAMP(next, -CONFIG_APP_SHT3XD_EMUL_WALK_RANGE,
+                          CONFIG_APP_SHT3XD_EMUL_WALK_RANGE);
+}
+
+static void sht3xd_emul_put_word(uint8_t *out, uint16_t word)
+{
+    out[0] = word >> 8;
+    out[1] = word & 0xFF;
+    out[2] = sht3xd_emul_crc(out, 2);
+}
+
+/* Latch a new reading, converted with the inverse of the datasheet formulas */
+static void sht3xd_emul_measure(struct sht3xd_emul_data *data)
+{
+    data->walk_temperature = sht3xd_emul_walk(data, data->walk_temperature);
+    data->walk_humidity = sht3xd_emul_walk(data, data->walk_humidity);
+
+    const int32_t temp = CLAMP(data->base_temperature + data->walk_temperature, -4500, 13000);
+    const int32_t hum = CLAMP(data->base_humidity + data->walk_humidity, 0, 10000);
+
+    /* T = -45 + 175 * raw / 65535, RH = 100 * raw / 65535 */
+    sht3xd_emul_put_word(&data->frame[0], (uint16_t)((temp + 4500) * 65535 / 17500));
+    sht3xd_emul_put_word(&data->frame[3], (uint16_t)(hum * 65535 / 10000));
+
+    data->frame_valid = true;
+    data->measurements++;
+}
+
+static bool sht3xd_emul_is_measure_cmd(uint16_t cmd)
+{
+    const uint8_t msb = cmd >> 8;
+
+    return msb == 0x24 || msb == 0x2C || cmd == SHT3XD_CMD_FETCH;
+}
+
+static int sht3xd_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+                                int addr)
+{
+    struct sht3xd_emul_data *data = target->data;
+
+    ARG_UNUSED(addr);
+
+    for (int i = 0; i < num_msgs; i++) {
+        struct i2c_msg *msg = &msgs[i];
+
+        if ((msg->flags & I2C_MSG_READ) == 0) {
+            if (msg->len < 2) {
+                return -EIO;
+            }
+            const uint16_t cmd = ((uint16_t)msg->buf[0] << 8) | msg->buf[1];
+
+            if (sht3xd_emul_is_measure_cmd(cmd)) {
+                sht3xd_emul_measure(data);
+            }
+            continue;
+        }
+
+        /* The real sensor NACKs reads without a pending measurement */
+        if (!data->frame_valid || msg->len > sizeof(data->frame)) {
+            return -EIO;
+        }
+        memcpy(msg->buf, data->frame, msg->len);
+        data->frame_valid = false;
+    }
+
+    return 0;
+}
+
+void sht3xd_emul_set_base(const struct emul *target, int16_t temperature, uint16_t humidity)
+{
+    struct sht3xd_emul_data *data = target->data;
+
+    data->base_temperature = temperature;
+    data->base_humidity = humidity;
+}
+
+uint32_t sht3xd_emul_measurements(const struct emul *target)
+{
+    const struct sht3xd_emul_data *data = target->data;
+
+    return data->measurements;
+}
+
+static int sht3xd_emul_init(const struct emul *target, const struct device *parent)
+{
+    struct sht3xd_emul_data *data = target->data;
+
+    ARG_UNUSED(parent);
+
+    data->base_temperature = CONFIG_APP_SHT3XD_EMUL_TEMPERATURE;
+    data->base_humidity = CONFIG_APP_SHT3XD_EMUL_HUMIDITY;
+    data->rng = 0x9E3779B9u ^ target->bus.i2c->addr;
+
+    LOG_INF("SHT3x emulator at 0x%02x", target->bus.i2c->addr);
+    return 0;
+}
+
+static const struct i2c_emul_api sht3xd_emul_api_i2c = {
+    .transfer = sht3xd_emul_transfer,
+};
+
+#define SHT3XD_EMUL(n)                                                                  \
+    static struct sht3xd_emul_data sht3xd_emul_data_##n;                                \
+    EMUL_DT_INST_DEFINE(n, sht3xd_emul_init, &sht3xd_emul_data_##n, NULL,               \
+                        &sht3xd_emul_api_i2c, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(SHT3XD_EMUL)
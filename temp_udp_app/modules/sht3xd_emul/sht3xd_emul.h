@@ -0,0 +1,39 @@
+/**
+ * @file sht3xd_emul.h
+ * @brief I2C emulator for the Sensirion SHT3x sensor (native_sim builds)
+ *
+ * The emulator answers the measurement commands of Zephyr's sht3xd driver
+ * with CRC protected raw frames. Readings follow a bounded random walk
+ * around a configurable base value, so the data looks like a real sensor
+ * in a slowly changing room while staying reproducible from run to run.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Move the base value of the random walk
+ *
+ * @param target      Emulator instance (EMUL_DT_GET(node))
+ * @param temperature Base temperature in 0.01 degrees Celsius
+ * @param humidity    Base relative humidity in 0.01 %
+ */
+void sht3xd_emul_set_base(const struct emul *target, int16_t temperature, uint16_t humidity);
+
+/**
+ * @brief Get the number of measurements served so far
+ *
+ * @param target Emulator instance
+ */
+uint32_t sht3xd_emul_measurements(const struct emul *target);
+
+#ifdef __cplusplus
+}
+#endif
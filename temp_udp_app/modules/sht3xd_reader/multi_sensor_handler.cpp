@@ -0,0 +1,189 @@
+/**
+ * @file multi_sensor_handler.cpp
+ * @brief Implementation of the multi-instance SHT3x sensor handler
+ *
+ * This file implements MultiSensorHandler. The sensor set is taken from
+ * the devicetree at compile time; readings of several sensors are
+ * overlapped with one worker thread per sensor, or with asynchronous RTIO
+ * reads from the calling thread when CONFIG_APP_SENSOR_ASYNC is enabled.
+ */
+
+#include "multi_sensor_handler.h"
+
+#include <zephyr/logging/log.h>
+
+#include "latency_stats.h"
+
+LOG_MODULE_REGISTER(multi_sensor_handler);
+
+/// Expands to one reader initializer per enabled devicetree node
+#if defined(CONFIG_APP_SENSOR_DIRECT)
+#define SHT3X_READER_INIT(node_id) SHT3xDirectReader{I2C_DT_SPEC_GET(node_id)},
+#else
+#define SHT3X_READER_INIT(node_id) SHT3xReader{DEVICE_DT_GET(node_id)},
+#endif
+
+#if DT_NUM_INST_STATUS_OKAY(sensirion_sht3xd) > 1 && !defined(CONFIG_APP_SENSOR_ASYNC)
+/// Worker threads are only needed when readings have to overlap
+#define SENSOR_WORKERS_ENABLED 1
+
+K_THREAD_STACK_ARRAY_DEFINE(sensor_worker_stacks, MultiSensorHandler::kSensorCount,
+                            CONFIG_APP_SENSOR_WORKER_STACK_SIZE);
+static struct k_thread sensor_worker_threads[MultiSensorHandler::kSensorCount];
+#endif
+
+/**
+ * @brief Constructor - create one reader per sensor and start the workers
+ *
+ * Worker threads are created immediately and block on their start
+ * semaphore until the first update().
+ */
+MultiSensorHandler::MultiSensorHandler()
+#if !defined(CONFIG_APP_SENSOR_ASYNC)
+    : readers_{DT_FOREACH_STATUS_OKAY(sensirion_sht3xd, SHT3X_READER_INIT)}
+#endif
+{
+    k_sem_init(&done_, 0, kSensorCount);
+
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        Worker& worker = workers_[i];
+        worker.owner = this;
+        worker.index = i;
+        worker.data = SensorData{};
+        worker.data.sensor = static_cast<uint8_t>(i);
+        worker.ok = false;
+        k_sem_init(&worker.start, 0, 1);
+
+#if defined(SENSOR_WORKERS_ENABLED)
+        k_thread_create(&sensor_worker_threads[i], sensor_worker_stacks[i],
+                        K_THREAD_STACK_SIZEOF(sensor_worker_stacks[i]), workerEntry, &worker,
+                        NULL, NULL, CONFIG_APP_SENSOR_WORKER_PRIORITY, 0, K_NO_WAIT);
+        k_thread_name_set(&sensor_worker_threads[i], "sensor_worker");
+#endif
+    }
+
+    LOG_INF("%u SHT3x sensor(s) configured", static_cast<unsigned>(kSensorCount));
+}
+
+/**
+ * @brief Sample all sensors once, overlapping the measurements
+ *
+ * All workers are started before waiting for any of them, so the total
+ * cycle time is roughly that of the slowest sensor.
+ *
+ * @return Number of sensors whose data was updated in this cycle
+ */
+size_t MultiSensorHandler::update() {
+    ScopedLatency measure(kStageSensorCycle);
+
+#if defined(CONFIG_APP_SENSOR_ASYNC)
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        workers_[i].ok = false;
+    }
+    async_.submitAll();
+    async_.collect(onFrame, this);
+#elif defined(SENSOR_WORKERS_ENABLED)
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        k_sem_give(&workers_[i].start);
+    }
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        k_sem_take(&done_, K_FOREVER);
+    }
+#else
+    workers_[0].ok = acquire(0);
+#endif
+
+    // Number the readings in sensor order; failed readings take no number
+    size_t updated = 0;
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        if (workers_[i].ok) {
+            workers_[i].data.sequence = sequence_++;
+            updated++;
+        }
+    }
+    return updated;
+}
+
+#if defined(CONFIG_APP_SENSOR_ASYNC)
+/**
+ * @brief Store one decoded asynchronous frame
+ *
+ * Called from update() while the completions of a cycle are consumed.
+ *
+ * @param frame Fixed-point reading
+ * @param user  Pointer to the MultiSensorHandler
+ */
+void MultiSensorHandler::onFrame(const SensorFrame& frame, void* user) {
+    MultiSensorHandler& self = *static_cast<MultiSensorHandler*>(user);
+    Worker& worker = self.workers_[frame.sensor];
+
+    worker.data.temperature = frame.temperature / 100.0f;
+    worker.data.humidity = frame.humidity / 100.0f;
+    worker.data.timestamp_us = frame.timestamp_ns / NSEC_PER_USEC;  // Capture time of the frame
+    worker.ok = true;
+}
+#else
+/**
+ * @brief Take one reading of a sensor and tag it
+ *
+ * In periodic mode the reader sleeps until its own next result (at most
+ * two measurement periods), which keeps every sensor aligned with its own
+ * conversion clock.
+ *
+ * @param index Sensor index
+ *
+ * @return true if the sensor delivered new data
+ */
+bool MultiSensorHandler::acquire(size_t index) {
+#if defined(CONFIG_APP_SENSOR_DIRECT)
+    SHT3xDirectReader& reader = readers_[index];
+    if (!reader.fetch()) {
+        return false;
+    }
+
+    // Already fixed-point; one division per channel for the in-memory float
+    SensorData& data = workers_[index].data;
+    data.temperature = reader.getTemperatureCenti() / 100.0f;
+    data.humidity = reader.getHumidityCenti() / 100.0f;
+    data.timestamp_us = DeviceClock::nowUs();  // Completion time of this sensor's reading
+    return true;
+#else
+    SHT3xReader& reader = readers_[index];
+
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    const bool ok = reader.waitForSample(K_MSEC(2 * SHT3xReader::kPeriodMs));
+#else
+    const bool ok = reader.fetch();
+#endif
+    if (!ok) {
+        return false;
+    }
+
+    SensorData& data = workers_[index].data;
+    data.temperature = static_cast<float>(reader.getTemperature());
+    data.humidity = static_cast<float>(reader.getHumidity());
+    data.timestamp_us = DeviceClock::nowUs();  // Completion time of this sensor's reading
+    return true;
+#endif
+}
+
+/**
+ * @brief Worker thread entry point
+ *
+ * Waits for update() to release it, takes one reading and reports
+ * completion through the shared done semaphore.
+ *
+ * @param p1 Pointer to the Worker context
+ */
+void MultiSensorHandler::workerEntry(void* p1, void* p2, void* p3) {
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+    Worker& worker = *static_cast<Worker*>(p1);
+
+    while (true) {
+        k_sem_take(&worker.start, K_FOREVER);
+        worker.ok = worker.owner->acquire(worker.index);
+        k_sem_give(&worker.owner->done_);
+    }
+}
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file multi_sensor_handler.h
+ * @brief Sensor handler for all SHT3x sensors enabled in the devicetree
+ *
+ * This header provides a compile-time multi-instance counterpart of
+ * SensorHandler. It owns one SHT3xReader per "sensirion,sht3xd" node with
+ * status "okay" and samples all of them in one cycle.
+ */
+
+#pragma once
+
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+
+#include <cstddef>
+
+#include "sensor_handler.h"
+#include "sht3xd_reader.h"
+
+#if defined(CONFIG_APP_SENSOR_ASYNC)
+#include "sht3xd_async_reader.h"
+#elif defined(CONFIG_APP_SENSOR_DIRECT)
+#include "sht3xd_direct_reader.h"
+#endif
+
+/**
+ * @brief Samples every SHT3x sensor of the board once per cycle
+ *
+ * The sensor set is built at compile time with DT_FOREACH_STATUS_OKAY, so
+ * enclosures with two SHT31s (addresses 0x44/0x45) or sensors on several
+ * I2C buses only need additional devicetree nodes.
+ *
+ * With more than one sensor, every reader gets a small worker thread.
+ * update() releases all workers at once and waits until each one has
+ * finished. The conversion wait of one sensor therefore overlaps with the
+ * others (the I2C driver releases the bus while a sensor converts) and
+ * the cycle time stays close to a single measurement instead of growing
+ * linearly with the number of sensors. With a single sensor the reading
+ * is taken inline without any extra thread.
+ *
+ * With CONFIG_APP_SENSOR_ASYNC no worker threads and no SHT3xReader
+ * instances exist. update() submits one RTIO read per sensor through
+ * SHT3xAsyncReader from the calling thread and handles all completions in
+ * one batch, so the overlap comes without a stack per sensor.
+ *
+ * With CONFIG_APP_SENSOR_DIRECT every node gets an SHT3xDirectReader
+ * instead, which measures with raw I2C commands and converts with integer
+ * arithmetic; threads and overlap work as with SHT3xReader.
+ *
+ * Every resulting SensorData is tagged with the sensor index, which is the
+ * position of the node in devicetree order, and with a per-boot sequence
+ * number counting the successful readings of all sensors.
+ *
+ * Usage example:
+ * @code
+ * static MultiSensorHandler sensors;
+ * sensors.update();
+ * for (size_t i = 0; i < MultiSensorHandler::kSensorCount; ++i) {
+ *     if (sensors.isValid(i)) {
+ *         send(sensors.getData(i));  // data.sensor == i
+ *     }
+ * }
+ * @endcode
+ */
+class MultiSensorHandler {
+public:
+    /// Number of enabled SHT3x sensors in the devicetree
+    static constexpr size_t kSensorCount = DT_NUM_INST_STATUS_OKAY(sensirion_sht3xd);
+    static_assert(kSensorCount > 0, "No sensirion,sht3xd node with status okay");
+
+    /**
+     * @brief Constructor - create one reader per sensor and start the workers
+     *
+     * @note Instances must have static storage duration, since worker
+     *       threads and timers keep pointers to them.
+     */
+    MultiSensorHandler();
+
+    MultiSensorHandler(const MultiSensorHandler&) = delete;
+    MultiSensorHandler& operator=(const MultiSensorHandler&) = delete;
+
+    /**
+     * @brief Sample all sensors once, overlapping the measurements
+     *
+     * In single-shot mode every sensor performs a conversion; in periodic
+     * mode every sensor waits for its own next result.
+     *
+     * @return Number of sensors whose data was updated in this cycle
+     */
+    size_t update();
+
+    /**
+     * @brief Check whether a sensor delivered data in the last cycle
+     *
+     * @param index Sensor index (0 to kSensorCount - 1)
+     */
+    inline bool isValid(size_t index) const {
+        return workers_[index].ok;
+    }
+
+    /**
+     * @brief Get the latest data of one sensor
+     *
+     * @param index Sensor index (0 to kSensorCount - 1)
+     *
+     * @return const SensorData& Cached data tagged with @p index
+     */
+    inline const SensorData& getData(size_t index) const {
+        return workers_[index].data;
+    }
+
+private:
+    /// Per-sensor state and worker thread context
+    struct Worker {
+        MultiSensorHandler* owner;  ///< Back reference for the thread entry
+        size_t index;               ///< Sensor index
+        SensorData data;            ///< Latest reading of this sensor
+        bool ok;                    ///< Reading of the last cycle succeeded
+        struct k_sem start;         ///< Released by update() to start a reading
+    };
+
+#if defined(CONFIG_APP_SENSOR_ASYNC)
+    /// Store one decoded asynchronous frame in its sensor slot
+    static void onFrame(const SensorFrame& frame, void* user);
+#else
+    /// Take one reading of sensor @p index (single-shot or periodic)
+    bool acquire(size_t index);
+
+    /// Worker thread entry point
+    static void workerEntry(void* p1, void* p2, void* p3);
+#endif
+
+#if defined(CONFIG_APP_SENSOR_ASYNC)
+    SHT3xAsyncReader async_;             ///< RTIO reads of all sensors
+#elif defined(CONFIG_APP_SENSOR_DIRECT)
+    SHT3xDirectReader readers_[kSensorCount];  ///< One reader per devicetree node
+#else
+    SHT3xReader readers_[kSensorCount];  ///< One reader per devicetree node
+#endif
+    Worker workers_[kSensorCount];       ///< Per-sensor state
+    struct k_sem done_;                  ///< Counts finished readings of the current cycle
+    uint32_t sequence_ = 0;              ///< Sequence number of the next successful reading
+};
@@ -11,20 +11,26 @@
 
 #include <zephyr/kernel.h>
 
+#include "device_clock.h"
 #include "sht3xd_reader.h"
 
 /**
  * @brief Sensor data structure containing temperature and humidity readings
  *
  * This structure stores the latest sensor readings in float precision
- * format optimized for network transmission. It includes automatic
- * timestamping for data correlation and is packed for efficient UDP transmission.
+ * format. It includes automatic timestamping for data correlation and a
+ * sequence number that lets the collector detect missing samples.
+ *
+ * @note This is the in-memory representation only. Samples are converted
+ *       to the fixed-point wire format (see sensor_protocol.h) for transmission.
  */
 struct SensorData {
     float temperature;   ///< Temperature in degrees Celsius
     float humidity;      ///< Relative humidity in percentage (0-100%)
-    uint32_t timestamp;  ///< System uptime in milliseconds when reading was taken
-} __attribute__((packed));
+    uint64_t timestamp_us;  ///< Uptime in microseconds when the reading completed (DeviceClock)
+    uint32_t sequence;      ///< Per-boot sample number, +1 per successful reading
+    uint8_t sensor;         ///< Index of the originating sensor (0 for single-sensor setups)
+};
 
 /**
  * @brief High-level sensor handler class for SHT31 temperature/humidity sensor
@@ -38,7 +44,7 @@ struct SensorData {
  * SensorHandler sensor;
  * if (sensor.update()) {                  // Read latest sensor values with error checking
  *     const auto& data = sensor.getData(); // Get cached readings with timestamp
- *     printf("Temp: %.2f°C at %u ms\n", data.temperature, data.timestamp);
+ *     printf("Temp: %.2f°C at %llu us\n", data.temperature, data.timestamp_us);
  * }
  * @endcode
  */
@@ -73,13 +79,39 @@ class SensorHandler {
             // Update cached data with fresh sensor readings
             data.temperature = static_cast<float>(reader.getTemperature());
             data.humidity = static_cast<float>(reader.getHumidity());
-            data.timestamp = k_uptime_get_32();  // Capture current system uptime
+            data.timestamp_us = DeviceClock::nowUs();  // Capture current system uptime
+            data.sequence++;
             return true;  // Indicate successful update
         }
         // Note: If fetch() fails, previous data remains unchanged
         return false;  // Indicate update failure
     }
 
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    /**
+     * @brief Sleep until the sensor has a new periodic reading and cache it
+     *
+     * Periodic-mode counterpart of update(): instead of the caller sleeping
+     * for a fixed interval, the thread is woken by the reader once the next
+     * conversion result is due (or the ALERT line fires).
+     *
+     * @param timeout Maximum time to wait for the next reading
+     *
+     * @return true if a new reading was fetched and data was updated
+     * @return false on timeout or read failure (previous data unchanged)
+     */
+    bool waitForUpdate(k_timeout_t timeout) {
+        if (reader.waitForSample(timeout)) {
+            data.temperature = static_cast<float>(reader.getTemperature());
+            data.humidity = static_cast<float>(reader.getHumidity());
+            data.timestamp_us = DeviceClock::nowUs();  // Capture current system uptime
+            data.sequence++;
+            return true;
+        }
+        return false;
+    }
+#endif
+
     /**
      * @brief Get the latest sensor data
      *
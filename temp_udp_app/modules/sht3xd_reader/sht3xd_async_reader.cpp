@@ -0,0 +1,175 @@
+/**
+ * @file sht3xd_async_reader.cpp
+ * @brief Implementation of asynchronous SHT3x reads via RTIO
+ *
+ * This file defines the read iodevs and the RTIO context for all SHT3x
+ * sensors and implements submission, completion handling and fixed-point
+ * decoding of the resulting frames.
+ */
+
+#include "sht3xd_async_reader.h"
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/rtio/rtio.h>
+
+LOG_MODULE_REGISTER(SHT3xAsyncReader);
+
+/// Unique iodev name per devicetree node
+#define SHT3X_IODEV_NAME(node_id) _CONCAT(sht3x_iodev_, DT_DEP_ORD(node_id))
+
+/// Read iodev for the temperature and humidity channels of one node
+#define SHT3X_IODEV_DEFINE(node_id)                                                   \
+    SENSOR_DT_READ_IODEV(SHT3X_IODEV_NAME(node_id), node_id,                          \
+                         {SENSOR_CHAN_AMBIENT_TEMP, 0}, {SENSOR_CHAN_HUMIDITY, 0});
+
+#define SHT3X_IODEV_PTR(node_id) &SHT3X_IODEV_NAME(node_id),
+#define SHT3X_DEVICE_PTR(node_id) DEVICE_DT_GET(node_id),
+
+DT_FOREACH_STATUS_OKAY(sensirion_sht3xd, SHT3X_IODEV_DEFINE)
+
+static struct rtio_iodev* const sht3x_iodevs[] = {
+    DT_FOREACH_STATUS_OKAY(sensirion_sht3xd, SHT3X_IODEV_PTR)};
+
+static const struct device* const sht3x_devices[] = {
+    DT_FOREACH_STATUS_OKAY(sensirion_sht3xd, SHT3X_DEVICE_PTR)};
+
+/// One submission/completion slot and one pool block per sensor
+RTIO_DEFINE_WITH_MEMPOOL(sht3x_rtio, SHT3xAsyncReader::kSensorCount,
+                         SHT3xAsyncReader::kSensorCount, SHT3xAsyncReader::kSensorCount,
+                         CONFIG_APP_SENSOR_ASYNC_FRAME_SIZE, sizeof(void*));
+
+/**
+ * @brief Convert a q31 value with shift to 0.01 unit fixed-point
+ *
+ * The decoded value is q31 * 2^shift / 2^31. Scaling by 100 first keeps
+ * two decimal places; the final shift rounds to nearest.
+ *
+ * @param value q31 mantissa
+ * @param shift Binary exponent reported by the decoder
+ *
+ * @return Value in 0.01 units
+ */
+static int32_t q31ToCenti(q31_t value, int8_t shift) {
+    int64_t scaled = static_cast<int64_t>(value) * 100;
+    const int total_shift = 31 - shift;
+
+    if (total_shift <= 0) {
+        return static_cast<int32_t>(scaled << -total_shift);
+    }
+    scaled += static_cast<int64_t>(1) << (total_shift - 1);  // Round to nearest
+    return static_cast<int32_t>(scaled >> total_shift);
+}
+
+/**
+ * @brief Constructor - check that all sensor devices are ready
+ */
+SHT3xAsyncReader::SHT3xAsyncReader() {
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        if (!device_is_ready(sht3x_devices[i])) {
+            LOG_ERR("SHT31 sensor device %s is not ready", sht3x_devices[i]->name);
+        }
+    }
+    LOG_INF("Asynchronous RTIO reads for %u sensor(s)", static_cast<unsigned>(kSensorCount));
+}
+
+/**
+ * @brief Queue one read per sensor without blocking
+ *
+ * @return Number of reads now in flight
+ */
+size_t SHT3xAsyncReader::submitAll() {
+    for (size_t i = 0; i < kSensorCount; ++i) {
+        // The sensor index travels with the request as userdata
+        int rc = sensor_read_async_mempool(sht3x_iodevs[i], &sht3x_rtio,
+                                           reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        if (rc != 0) {
+            LOG_ERR("Async read submission for sensor %u failed with error code: %d",
+                    static_cast<unsigned>(i), rc);
+            continue;
+        }
+        in_flight_++;
+    }
+    return in_flight_;
+}
+
+/**
+ * @brief Wait for all reads in flight and decode them
+ *
+ * @return Number of frames passed to @p handler
+ */
+size_t SHT3xAsyncReader::collect(FrameHandler handler, void* user) {
+    size_t decoded = 0;
+
+    while (in_flight_ > 0) {
+        struct rtio_cqe* cqe = rtio_cqe_consume_block(&sht3x_rtio);
+        in_flight_--;
+
+        const int result = cqe->result;
+        const size_t sensor = reinterpret_cast<uintptr_t>(cqe->userdata);
+
+        uint8_t* buf = nullptr;
+        uint32_t buf_len = 0;
+        int rc = rtio_cqe_get_mempool_buffer(&sht3x_rtio, cqe, &buf, &buf_len);
+        rtio_cqe_release(&sht3x_rtio, cqe);
+
+        if (result != 0 || rc != 0) {
+            LOG_ERR("Async read of sensor %u failed with error code: %d",
+                    static_cast<unsigned>(sensor), result != 0 ? result : rc);
+        } else {
+            SensorFrame frame;
+            if (decode(sensor, buf, frame)) {
+                handler(frame, user);
+                decoded++;
+            }
+        }
+
+        if (buf != nullptr) {
+            rtio_release_buffer(&sht3x_rtio, buf, buf_len);
+        }
+    }
+
+    return decoded;
+}
+
+/**
+ * @brief Decode the temperature and humidity channels of one frame
+ *
+ * @param sensor Sensor index, selects the decoder of the matching device
+ * @param buf    Encoded frame from the RTIO memory pool
+ * @param frame  Receives the fixed-point reading
+ *
+ * @return true if both channels were decoded
+ */
+bool SHT3xAsyncReader::decode(size_t sensor, const uint8_t* buf, SensorFrame& frame) const {
+    if (sensor >= kSensorCount) {
+        return false;
+    }
+
+    const struct sensor_decoder_api* decoder;
+    int rc = sensor_get_decoder(sht3x_devices[sensor], &decoder);
+    if (rc != 0) {
+        LOG_ERR("No decoder for sensor %u (error code: %d)", static_cast<unsigned>(sensor), rc);
+        return false;
+    }
+
+    struct sensor_q31_data temp = {};
+    struct sensor_q31_data hum = {};
+    uint32_t temp_fit = 0;
+    uint32_t hum_fit = 0;
+
+    if (decoder->decode(buf, {SENSOR_CHAN_AMBIENT_TEMP, 0}, &temp_fit, 1, &temp) <= 0 ||
+        decoder->decode(buf, {SENSOR_CHAN_HUMIDITY, 0}, &hum_fit, 1, &hum) <= 0) {
+        LOG_ERR("Decoding frame of sensor %u failed", static_cast<unsigned>(sensor));
+        return false;
+    }
+
+    const int32_t temp_centi = q31ToCenti(temp.readings[0].temperature, temp.shift);
+    const int32_t hum_centi = q31ToCenti(hum.readings[0].humidity, hum.shift);
+
+    frame.sensor = static_cast<uint8_t>(sensor);
+    frame.temperature = static_cast<int16_t>(CLAMP(temp_centi, INT16_MIN, INT16_MAX));
+    frame.humidity = static_cast<uint16_t>(CLAMP(hum_centi, 0, UINT16_MAX));
+    frame.timestamp_ns = temp.header.base_timestamp_ns + temp.readings[0].timestamp_delta;
+    return true;
+}
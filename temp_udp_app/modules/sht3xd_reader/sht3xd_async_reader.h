@@ -0,0 +1,92 @@
+/**
+ * @file sht3xd_async_reader.h
+ * @brief Asynchronous SHT3x reads through Zephyr's RTIO sensor API
+ *
+ * This header provides a non-blocking alternative to SHT3xReader. Reads of
+ * all SHT3x sensors are submitted to an RTIO context and completed frames
+ * are decoded into fixed-point values, without double conversions and
+ * without a blocked thread per sensor.
+ */
+
+#pragma once
+
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief One decoded reading in fixed-point representation
+ */
+struct SensorFrame {
+    uint8_t sensor;         ///< Sensor index (devicetree order)
+    int16_t temperature;    ///< Temperature in 0.01 degrees Celsius
+    uint16_t humidity;      ///< Relative humidity in 0.01 %
+    uint64_t timestamp_ns;  ///< Capture time reported by the sensor API
+};
+
+/**
+ * @brief Submits reads for all SHT3x sensors and decodes the completions
+ *
+ * Every "sensirion,sht3xd" node with status "okay" gets a read iodev for
+ * the temperature and humidity channels. submitAll() queues one read per
+ * sensor with sensor_read_async_mempool() and returns immediately; the
+ * buffers come from the RTIO memory pool. collect() then consumes all
+ * completions in one batch and decodes them with the driver's decoder into
+ * q31 values, which are converted to 0.01 unit fixed-point with integer
+ * arithmetic only.
+ *
+ * A single thread can therefore keep reads of all sensors in flight at the
+ * same time. Drivers without native async support are served by the
+ * sensor subsystem's RTIO work queue fallback.
+ *
+ * Usage example:
+ * @code
+ * static SHT3xAsyncReader reader;
+ * reader.submitAll();
+ * reader.collect([](const SensorFrame& frame, void* user) { ... }, nullptr);
+ * @endcode
+ */
+class SHT3xAsyncReader {
+public:
+    /// Number of enabled SHT3x sensors in the devicetree
+    static constexpr size_t kSensorCount = DT_NUM_INST_STATUS_OKAY(sensirion_sht3xd);
+
+    /// Callback invoked for every successfully decoded frame
+    using FrameHandler = void (*)(const SensorFrame& frame, void* user);
+
+    /**
+     * @brief Constructor - check that all sensor devices are ready
+     */
+    SHT3xAsyncReader();
+
+    SHT3xAsyncReader(const SHT3xAsyncReader&) = delete;
+    SHT3xAsyncReader& operator=(const SHT3xAsyncReader&) = delete;
+
+    /**
+     * @brief Queue one read per sensor without blocking
+     *
+     * @return Number of reads now in flight
+     */
+    size_t submitAll();
+
+    /**
+     * @brief Wait for all reads in flight and decode them
+     *
+     * Completion queue entries are consumed in a batch; failed reads and
+     * frames that cannot be decoded are logged and skipped.
+     *
+     * @param handler Called for every successfully decoded frame
+     * @param user    Opaque pointer passed to @p handler
+     *
+     * @return Number of frames passed to @p handler
+     */
+    size_t collect(FrameHandler handler, void* user);
+
+private:
+    /// Decode the temperature and humidity channels of one frame
+    bool decode(size_t sensor, const uint8_t* buf, SensorFrame& frame) const;
+
+    size_t in_flight_ = 0;  ///< Submitted reads not yet collected
+};
@@ -0,0 +1,182 @@
+/**
+ * @file sht3xd_direct_reader.cpp
+ * @brief Implementation of direct I2C single-shot reads of the SHT3x
+ *
+ * This file implements the command/read transaction, the CRC check of the
+ * result frame, the integer conversion and the "sensor repeat" command.
+ */
+
+#include "sht3xd_direct_reader.h"
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+#include <errno.h>
+#include <cstring>
+#endif
+
+#include "latency_stats.h"
+
+LOG_MODULE_REGISTER(SHT3xDirectReader);
+
+static_assert(SHT3xDirectReader::toCentiCelsius(0) == -4500, "T(0) must be -45 C");
+static_assert(SHT3xDirectReader::toCentiCelsius(0xFFFF) == 13000, "T(max) must be 130 C");
+static_assert(SHT3xDirectReader::toCentiPercent(0xFFFF) == 10000, "RH(max) must be 100 %");
+
+/// Single-shot commands with clock stretching, indexed by Repeatability
+static constexpr uint16_t kSingleShotCommand[] = {0x2C10, 0x2C0D, 0x2C06};
+
+/// Longest conversion times from the datasheet in us, indexed by Repeatability
+static constexpr uint32_t kMaxDurationUs[] = {4500, 6500, 15500};
+
+static const char* const repeatability_names[] = {"low", "medium", "high"};
+
+/// Size of the result frame: temperature word, CRC, humidity word, CRC
+static constexpr size_t kFrameSize = 6;
+
+/// CRC-8 lookup table (polynomial 0x31), one step per byte instead of per bit
+struct Crc8Table {
+    uint8_t value[256];
+
+    constexpr Crc8Table() : value{} {
+        for (int i = 0; i < 256; ++i) {
+            uint8_t crc = static_cast<uint8_t>(i);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31)
+                                   : static_cast<uint8_t>(crc << 1);
+            }
+            value[i] = crc;
+        }
+    }
+};
+
+static constexpr Crc8Table kCrc8Table;
+
+static_assert(kCrc8Table.value[kCrc8Table.value[0xFF ^ 0xBE] ^ 0xEF] == 0x92,
+              "Datasheet example: CRC(0xBEEF) = 0x92");
+
+std::atomic<SHT3xDirectReader::Repeatability> SHT3xDirectReader::repeatability_{
+#if defined(CONFIG_SHT3XD_REPEATABILITY_LOW)
+    Repeatability::kLow
+#elif defined(CONFIG_SHT3XD_REPEATABILITY_MEDIUM)
+    Repeatability::kMedium
+#else
+    Repeatability::kHigh
+#endif
+};
+
+/**
+ * @brief Constructor - check that the I2C bus is ready
+ *
+ * @param bus I2C bus and address of the sensor
+ */
+SHT3xDirectReader::SHT3xDirectReader(const struct i2c_dt_spec& bus) : bus_(bus) {
+    if (!i2c_is_ready_dt(&bus_)) {
+        LOG_ERR("I2C bus %s for SHT3x at 0x%02x is not ready", bus_.bus->name, bus_.addr);
+    } else {
+        LOG_INF("SHT3x at %s/0x%02x read with direct I2C commands, %s repeatability",
+                bus_.bus->name, bus_.addr, name(repeatability()));
+    }
+}
+
+/**
+ * @brief Take one single-shot measurement
+ *
+ * Writes the measurement command and reads the result frame with a
+ * repeated start; the sensor stretches the clock until the conversion is
+ * complete. The frame is only accepted if the CRCs of both words match.
+ *
+ * @return true if new values were cached
+ */
+bool SHT3xDirectReader::fetch() {
+    const Repeatability current = repeatability();
+    uint8_t command[2];
+    sys_put_be16(kSingleShotCommand[static_cast<size_t>(current)], command);
+
+    uint8_t frame[kFrameSize];
+    int rc;
+    {
+        ScopedLatency measure(kStageFetch);
+        rc = i2c_write_read_dt(&bus_, command, sizeof(command), frame, sizeof(frame));
+    }
+    if (rc != 0) {
+        LOG_ERR("SHT3x 0x%02x measurement failed with error code: %d", bus_.addr, rc);
+        return false;
+    }
+
+    if (crc8(&frame[0], 2) != frame[2] || crc8(&frame[3], 2) != frame[5]) {
+        crc_errors_++;
+        LOG_WRN("SHT3x 0x%02x frame CRC mismatch (%u in total)", bus_.addr, crc_errors_);
+        return false;
+    }
+
+    temperature_ = toCentiCelsius(sys_get_be16(&frame[0]));
+    humidity_ = toCentiPercent(sys_get_be16(&frame[3]));
+
+    LOG_DBG("Sensor reading successful: %d c°C, %u c%%RH", temperature_, humidity_);
+    return true;
+}
+
+void SHT3xDirectReader::setRepeatability(Repeatability repeatability) {
+    repeatability_.store(repeatability, std::memory_order_relaxed);
+}
+
+SHT3xDirectReader::Repeatability SHT3xDirectReader::repeatability() {
+    return repeatability_.load(std::memory_order_relaxed);
+}
+
+const char* SHT3xDirectReader::name(Repeatability repeatability) {
+    return repeatability_names[static_cast<size_t>(repeatability)];
+}
+
+uint32_t SHT3xDirectReader::maxDurationUs(Repeatability repeatability) {
+    return kMaxDurationUs[static_cast<size_t>(repeatability)];
+}
+
+/**
+ * @brief Sensirion CRC-8: polynomial 0x31, init 0xFF, no reflection
+ *
+ * Table driven; the 256-byte table lives in flash.
+ */
+uint8_t SHT3xDirectReader::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc = kCrc8Table.value[crc ^ data[i]];
+    }
+    return crc;
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief "sensor repeat [low|medium|high]" - print or select the repeatability
+ */
+static int cmd_sensor_repeat(const struct shell* sh, size_t argc, char** argv) {
+    using Repeatability = SHT3xDirectReader::Repeatability;
+
+    if (argc > 1) {
+        size_t i = 0;
+        while (i < ARRAY_SIZE(repeatability_names) &&
+               strcmp(argv[1], repeatability_names[i]) != 0) {
+            ++i;
+        }
+        if (i == ARRAY_SIZE(repeatability_names)) {
+            shell_error(sh, "Unknown repeatability: %s (low, medium or high)", argv[1]);
+            return -EINVAL;
+        }
+        SHT3xDirectReader::setRepeatability(static_cast<Repeatability>(i));
+    }
+
+    const Repeatability current = SHT3xDirectReader::repeatability();
+    shell_print(sh, "repeatability: %s (conversion up to %u us)",
+                SHT3xDirectReader::name(current), SHT3xDirectReader::maxDurationUs(current));
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), repeat, NULL,
+                 "Repeatability of the direct I2C measurements\n"
+                 "Usage: sensor repeat [low|medium|high]",
+                 cmd_sensor_repeat, 1, 1);
+#endif
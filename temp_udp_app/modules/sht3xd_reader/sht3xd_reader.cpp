@@ -13,6 +13,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include "latency_stats.h"
+
 LOG_MODULE_REGISTER(SHT3xReader);
 
 /**
@@ -25,13 +27,45 @@ LOG_MODULE_REGISTER(SHT3xReader);
  * 
  * Initializes cached temperature and humidity values to zero.
  */
-SHT3xReader::SHT3xReader() : dev_(DEVICE_DT_GET_ONE(sensirion_sht3xd)), temp_(0), hum_(0) {
+SHT3xReader::SHT3xReader() : SHT3xReader(DEVICE_DT_GET_ONE(sensirion_sht3xd)) {
+}
+
+/**
+ * @brief Constructor - Initialize a specific SHT3x sensor device
+ *
+ * Checks if the given device is ready for operation and, in periodic
+ * mode, starts the measurement period timer and registers the ALERT
+ * trigger for this instance.
+ *
+ * @param dev Sensor device instance
+ */
+SHT3xReader::SHT3xReader(const struct device *dev) : dev_(dev), temp_(0), hum_(0) {
     // Check if the SHT31 sensor device is ready for operation
     if (!device_is_ready(dev_)) {
         LOG_ERR("SHT31 sensor device %s is not ready", dev_->name);
     } else {
         LOG_INF("SHT31 sensor device %s initialized successfully", dev_->name);
     }
+
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    // The driver starts periodic conversions at init; wake up once per period
+    k_sem_init(&data_ready_, 0, 1);
+    k_timer_init(&period_timer_, onPeriod, NULL);
+    k_timer_user_data_set(&period_timer_, this);
+    k_timer_start(&period_timer_, K_MSEC(kPeriodMs), K_MSEC(kPeriodMs));
+    LOG_INF("Periodic mode: one measurement every %u ms", kPeriodMs);
+
+#if defined(CONFIG_SHT3XD_TRIGGER)
+    // Additionally wake up immediately when the ALERT line reports a threshold crossing
+    alert_.trig.type = SENSOR_TRIG_THRESHOLD;
+    alert_.trig.chan = SENSOR_CHAN_ALL;
+    alert_.owner = this;
+    int rc = sensor_trigger_set(dev_, &alert_.trig, onAlert);
+    if (rc != 0) {
+        LOG_WRN("ALERT trigger not available (error code: %d), using period timer only", rc);
+    }
+#endif
+#endif
 }
 
 /**
@@ -52,9 +86,18 @@ SHT3xReader::SHT3xReader() : dev_(DEVICE_DT_GET_ONE(sensirion_sht3xd)), temp_(0)
  */
 bool SHT3xReader::fetch() {
     // Trigger sensor measurement - initiates I2C communication
-    int rc = sensor_sample_fetch(dev_);
+    int rc;
+    {
+        ScopedLatency measure(kStageFetch);
+        rc = sensor_sample_fetch(dev_);
+    }
     if (rc != 0) {
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+        // In periodic mode the sensor NACKs the read until a new result is available
+        LOG_DBG("No new periodic measurement available (error code: %d)", rc);
+#else
         LOG_ERR("Sensor sample fetch failed with error code: %d", rc);
+#endif
         return false;
     }
 
@@ -62,14 +105,20 @@ bool SHT3xReader::fetch() {
     struct sensor_value temperature_raw, humidity_raw;
     
     // Read temperature channel from sensor
-    rc = sensor_channel_get(dev_, SENSOR_CHAN_AMBIENT_TEMP, &temperature_raw);
+    {
+        ScopedLatency measure(kStageChannelTemperature);
+        rc = sensor_channel_get(dev_, SENSOR_CHAN_AMBIENT_TEMP, &temperature_raw);
+    }
     if (rc != 0) {
         LOG_ERR("Temperature channel read failed with error code: %d", rc);
         return false;
     }
     
     // Read humidity channel from sensor
-    rc = sensor_channel_get(dev_, SENSOR_CHAN_HUMIDITY, &humidity_raw);
+    {
+        ScopedLatency measure(kStageChannelHumidity);
+        rc = sensor_channel_get(dev_, SENSOR_CHAN_HUMIDITY, &humidity_raw);
+    }
     if (rc != 0) {
         LOG_ERR("Humidity channel read failed with error code: %d", rc);
         return false;
@@ -79,6 +128,75 @@ bool SHT3xReader::fetch() {
     temp_ = sensor_value_to_double(&temperature_raw);  // Convert to degrees Celsius
     hum_ = sensor_value_to_double(&humidity_raw);      // Convert to percentage (0-100%)
     
-    LOG_DBG("Sensor reading successful: %.2f°C, %.2f%%", temp_, hum_);
+    // Integer arguments only: no float formatting, dictionary logging compatible
+    LOG_DBG("Sensor reading successful: %d m°C, %d m%%RH",
+            static_cast<int>(sensor_value_to_milli(&temperature_raw)),
+            static_cast<int>(sensor_value_to_milli(&humidity_raw)));
     return true;
 }
+
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+/**
+ * @brief Sleep until the next periodic measurement and fetch it
+ *
+ * The period timer runs on the MCU clock while the sensor converts on its
+ * own oscillator, so the two drift apart over time. If the sensor has no
+ * new result when the timer fires, the read is retried every kRetryMs for
+ * at most one period. The first successful retry happens right after a
+ * conversion completed, so the timer is restarted from that point, which
+ * keeps later wake-ups aligned with the sensor.
+ *
+ * @param timeout Maximum time to wait for the wake-up
+ *
+ * @return true if a new reading was fetched
+ * @return false on timeout or if no new data could be read
+ */
+bool SHT3xReader::waitForSample(k_timeout_t timeout) {
+    // CPU sleeps here until the sensor result is due or ALERT fires
+    if (k_sem_take(&data_ready_, timeout) != 0) {
+        return false;
+    }
+
+    if (fetch()) {
+        return true;
+    }
+
+    // Sensor not ready yet: poll briefly and re-align the period timer
+    for (uint32_t waited = 0; waited < kPeriodMs; waited += kRetryMs) {
+        k_sleep(K_MSEC(kRetryMs));
+        if (fetch()) {
+            k_timer_start(&period_timer_, K_MSEC(kPeriodMs), K_MSEC(kPeriodMs));
+            k_sem_reset(&data_ready_);
+            LOG_DBG("Period timer re-aligned after %u ms", waited + kRetryMs);
+            return true;
+        }
+    }
+
+    LOG_ERR("No periodic measurement received within %u ms", kPeriodMs);
+    return false;
+}
+
+/**
+ * @brief Period timer expiry - a new conversion result is due
+ *
+ * @param timer Expired timer; its user data points to the owning reader
+ */
+void SHT3xReader::onPeriod(struct k_timer *timer) {
+    auto *self = static_cast<SHT3xReader *>(k_timer_user_data_get(timer));
+    k_sem_give(&self->data_ready_);
+}
+
+#if defined(CONFIG_SHT3XD_TRIGGER)
+/**
+ * @brief ALERT trigger handler - wake the waiting thread immediately
+ *
+ * @param dev  Sensor device that raised the trigger
+ * @param trig Registered trigger, embedded in the reader's AlertContext
+ */
+void SHT3xReader::onAlert(const struct device *dev, const struct sensor_trigger *trig) {
+    ARG_UNUSED(dev);
+    const auto *ctx = CONTAINER_OF(trig, AlertContext, trig);
+    k_sem_give(&ctx->owner->data_ready_);
+}
+#endif
+#endif
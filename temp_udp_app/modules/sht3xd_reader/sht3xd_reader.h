@@ -11,6 +11,9 @@
 
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+
+#include <cstdint>
 
 /**
  * @brief SHT31/SHT3x temperature and humidity sensor reader class
@@ -22,6 +25,14 @@
  * The sensor communicates via I2C and provides high-precision temperature
  * and humidity measurements suitable for environmental monitoring applications.
  * 
+ * Two acquisition modes are supported, selected through the driver Kconfig:
+ * - Single-shot (CONFIG_SHT3XD_SINGLE_SHOT_MODE): every fetch() starts a
+ *   conversion and blocks for the whole measurement time.
+ * - Periodic (CONFIG_SHT3XD_PERIODIC_MODE): the sensor converts on its own
+ *   at 0.5/1/2/4/10 measurements per second (CONFIG_SHT3XD_MPS_*). fetch()
+ *   only reads the already converted result and waitForSample() sleeps
+ *   until the next result is due or the ALERT line fires.
+ *
  * Usage example:
  * @code
  * SHT3xReader sensor;
@@ -29,10 +40,31 @@
  *     double temp = sensor.getTemperature();  // Get temperature in Celsius
  *     double hum = sensor.getHumidity();      // Get humidity in percentage
  * }
+ *
+ * // Periodic mode: CPU sleeps until the sensor has new data
+ * while (sensor.waitForSample(K_FOREVER)) {
+ *     double temp = sensor.getTemperature();
+ * }
  * @endcode
  */
 class SHT3xReader {
 public:
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    /// Measurement period of the sensor in periodic mode, derived from CONFIG_SHT3XD_MPS_*
+    static constexpr uint32_t kPeriodMs =
+#if defined(CONFIG_SHT3XD_MPS_05)
+        2000;
+#elif defined(CONFIG_SHT3XD_MPS_1)
+        1000;
+#elif defined(CONFIG_SHT3XD_MPS_2)
+        500;
+#elif defined(CONFIG_SHT3XD_MPS_4)
+        250;
+#else
+        100;
+#endif
+#endif
+
     /**
      * @brief Constructor - initializes the SHT31 sensor
      * 
@@ -42,6 +74,19 @@ public:
      */
     SHT3xReader();
 
+    /**
+     * @brief Constructor - initializes a specific SHT3x sensor instance
+     *
+     * Used when several sensors are present (e.g. 0x44 and 0x45, or
+     * sensors on different I2C buses), see MultiSensorHandler.
+     *
+     * @param dev Sensor device, typically DEVICE_DT_GET(node_id)
+     */
+    explicit SHT3xReader(const struct device *dev);
+
+    SHT3xReader(const SHT3xReader &) = delete;
+    SHT3xReader &operator=(const SHT3xReader &) = delete;
+
     /**
      * @brief Fetch fresh sensor readings from hardware
      * 
@@ -57,6 +102,26 @@ public:
      */
     bool fetch();
 
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    /**
+     * @brief Sleep until the next periodic measurement and fetch it
+     *
+     * Blocks the calling thread until the next conversion result is due
+     * (one sensor measurement period) or the sensor ALERT line fires, then
+     * reads the converted data. If the sensor has no new result yet, the
+     * read is retried in short steps and the wake-up timer is re-aligned
+     * to the sensor's own measurement clock.
+     *
+     * @param timeout Maximum time to wait for the wake-up
+     *
+     * @return true if a new reading was fetched
+     * @return false on timeout or if no new data could be read
+     *
+     * @note Only available with CONFIG_SHT3XD_PERIODIC_MODE
+     */
+    bool waitForSample(k_timeout_t timeout);
+#endif
+
     /**
      * @brief Get the latest temperature reading
      * 
@@ -91,4 +156,28 @@ private:
     const struct device *dev_;  ///< Pointer to Zephyr sensor device instance
     double temp_;               ///< Cached temperature reading in degrees Celsius
     double hum_;                ///< Cached humidity reading in percentage
+
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    /// Delay between read attempts while the sensor has no new result
+    static constexpr uint32_t kRetryMs = 5;
+
+    /// Timer expiry handler signalling that a new conversion is due
+    static void onPeriod(struct k_timer *timer);
+
+    struct k_timer period_timer_;  ///< Fires once per sensor measurement period
+    struct k_sem data_ready_;      ///< Given by the period timer and the ALERT trigger
+
+#if defined(CONFIG_SHT3XD_TRIGGER)
+    /// Trigger registration with a back reference to the owning reader
+    struct AlertContext {
+        struct sensor_trigger trig;
+        SHT3xReader *owner;
+    };
+
+    /// Sensor trigger handler invoked when the ALERT line fires
+    static void onAlert(const struct device *dev, const struct sensor_trigger *trig);
+
+    AlertContext alert_;  ///< ALERT trigger registration
+#endif
+#endif
 };
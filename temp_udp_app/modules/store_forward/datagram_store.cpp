@@ -0,0 +1,227 @@
+/**
+ * @file datagram_store.cpp
+ * @brief Implementation of the flash-backed store-and-forward buffer
+ *
+ * This file implements page batching on top of the FCB, the replay of
+ * stored pages and the rate limit of the backfill.
+ */
+
+#include "datagram_store.h"
+
+#include <zephyr/logging/log.h>
+
+#include <errno.h>
+#include <cstring>
+
+#include "sensor_protocol.h"
+
+LOG_MODULE_REGISTER(datagram_store);
+
+/// FCB magic of the store ("SHSF")
+static constexpr uint32_t kFcbMagic = 0x53485346;
+
+/// FCB layout version; bump when the page format changes
+static constexpr uint8_t kFcbVersion = 1;
+
+/**
+ * @brief Open the circular log on storage_partition
+ *
+ * @return true if the store is usable
+ */
+bool DatagramStore::init() {
+    const int area_id = FIXED_PARTITION_ID(storage_partition);
+
+    uint32_t count = kMaxSectors;
+    int rc = flash_area_get_sectors(area_id, &count, sectors_);
+    if (rc != 0) {
+        LOG_ERR("Cannot get sectors of storage_partition (error code: %d)", rc);
+        return false;
+    }
+
+    fcb_.f_magic = kFcbMagic;
+    fcb_.f_version = kFcbVersion;
+    fcb_.f_sectors = sectors_;
+    fcb_.f_sector_cnt = static_cast<uint8_t>(count);
+    fcb_.f_scratch_cnt = 0;
+
+    rc = fcb_init(area_id, &fcb_);
+    if (rc != 0) {
+        LOG_ERR("Cannot open flash circular buffer (error code: %d)", rc);
+        return false;
+    }
+
+    // Pages are written whole, so they must be a multiple of the write block
+    if (kPageSize % fcb_.f_align != 0) {
+        LOG_ERR("Page size %u is not a multiple of the flash write block %u",
+                static_cast<unsigned>(kPageSize), fcb_.f_align);
+        return false;
+    }
+
+    ready_ = true;
+    flash_pending_ = !fcb_is_empty(&fcb_);
+    LOG_INF("Store-and-forward on %u sectors of %u bytes%s", count,
+            static_cast<unsigned>(sectors_[0].fs_size),
+            flash_pending_ ? ", stored datagrams pending" : "");
+    return true;
+}
+
+/**
+ * @brief Queue a datagram in the RAM page
+ *
+ * The datagram is marked with kFlagBackfill when it is copied, so a page
+ * can be replayed byte by byte later.
+ *
+ * @return true if the datagram was stored
+ */
+bool DatagramStore::append(const uint8_t* datagram, size_t len) {
+    if (!ready_ || len < SensorProtocol::kHeaderSize || len > kMaxDatagram) {
+        stats_.rejected++;
+        return false;
+    }
+
+    if (page_len_ + kRecordHeaderSize + len > kPageSize) {
+        writePage();
+    }
+
+    uint8_t* p = page_ + page_len_;
+    p[0] = static_cast<uint8_t>(len >> 8);
+    p[1] = static_cast<uint8_t>(len);
+    memcpy(p + kRecordHeaderSize, datagram, len);
+    SensorProtocol::setFlags(p + kRecordHeaderSize, len, kFlagBackfill);
+
+    page_len_ += kRecordHeaderSize + len;
+    stats_.stored++;
+    return true;
+}
+
+/**
+ * @brief Replay up to one burst of stored datagrams
+ *
+ * Flash pages are replayed oldest first. Once the flash is drained, the
+ * partially filled RAM page is replayed directly, which saves writing it.
+ *
+ * @return Number of datagrams replayed
+ */
+size_t DatagramStore::backfill(UdpClient& client, int64_t now) {
+    if (!ready_ || now < next_burst_ || !pending()) {
+        return 0;
+    }
+    next_burst_ = now + CONFIG_APP_STORE_FORWARD_BURST_INTERVAL_MS;
+
+    size_t sent = 0;
+    while (sent < CONFIG_APP_STORE_FORWARD_BURST) {
+        if (read_len_ == 0 && !readPage()) {
+            if (page_len_ == 0) {
+                break;
+            }
+            memcpy(read_page_, page_, page_len_);
+            read_len_ = page_len_;
+            read_off_ = 0;
+            page_len_ = 0;
+            memset(page_, 0, sizeof(page_));
+        }
+
+        // A zero length (padding) or a truncated record ends the page
+        const uint8_t* p = read_page_ + read_off_;
+        const size_t len = read_off_ + kRecordHeaderSize <= read_len_
+                               ? (static_cast<size_t>(p[0]) << 8) | p[1]
+                               : 0;
+        if (len == 0 || read_off_ + kRecordHeaderSize + len > read_len_) {
+            read_len_ = 0;
+            continue;
+        }
+
+        // Keep the datagram for the next burst if the network is still busy
+        if (client.send(p + kRecordHeaderSize, len) != SendResult::kOk) {
+            break;
+        }
+        read_off_ += kRecordHeaderSize + len;
+        stats_.backfilled++;
+        sent++;
+    }
+
+    if (sent > 0 && !pending()) {
+        LOG_INF("Backfill complete: %u datagrams replayed in total", stats_.backfilled);
+    }
+    return sent;
+}
+
+/**
+ * @brief Write the RAM page as one FCB entry
+ *
+ * If the log is full, the oldest sector is erased first. Erasing blocks the
+ * calling (transmit) thread for the sector erase time; sampling continues
+ * in its own thread.
+ *
+ * @return true if the page was written
+ */
+bool DatagramStore::writePage() {
+    struct fcb_entry loc{};
+    int rc = fcb_append(&fcb_, kPageSize, &loc);
+
+    if (rc == -ENOSPC) {
+        // The oldest sector is given up; restart reading at the new oldest one
+        if (read_loc_.fe_sector == nullptr || read_loc_.fe_sector == fcb_.f_oldest) {
+            read_loc_ = {};
+        }
+        stats_.overflows++;
+        rc = fcb_rotate(&fcb_);
+        if (rc == 0) {
+            rc = fcb_append(&fcb_, kPageSize, &loc);
+        }
+    }
+    if (rc == 0) {
+        rc = flash_area_write(fcb_.fap, FCB_ENTRY_FA_DATA_OFF(loc), page_, kPageSize);
+    }
+    if (rc == 0) {
+        rc = fcb_append_finish(&fcb_, &loc);
+    }
+
+    page_len_ = 0;
+    memset(page_, 0, sizeof(page_));
+
+    if (rc != 0) {
+        LOG_ERR("Flash page write failed (error code: %d)", rc);
+        return false;
+    }
+    stats_.pages_written++;
+    flash_pending_ = true;
+    return true;
+}
+
+/**
+ * @brief Load the next stored page into the read buffer
+ *
+ * A sector is erased as soon as reading moves past its last page, so the
+ * oldest sector is always the one being replayed.
+ *
+ * @return true if a page was loaded
+ */
+bool DatagramStore::readPage() {
+    if (!flash_pending_) {
+        return false;
+    }
+
+    struct fcb_entry loc = read_loc_;
+    struct flash_sector* previous = read_loc_.fe_sector;
+    if (fcb_getnext(&fcb_, &loc) != 0) {
+        flash_pending_ = false;
+        return false;
+    }
+
+    if (previous != nullptr && loc.fe_sector != previous && previous == fcb_.f_oldest) {
+        fcb_rotate(&fcb_);
+    }
+    read_loc_ = loc;
+
+    const size_t len = loc.fe_data_len < kPageSize ? loc.fe_data_len : kPageSize;
+    const int rc = fcb_flash_read(&fcb_, loc.fe_sector, loc.fe_data_off, read_page_, len);
+    if (rc != 0) {
+        LOG_ERR("Flash page read failed (error code: %d), page skipped", rc);
+        return false;
+    }
+
+    read_len_ = len;
+    read_off_ = 0;
+    return true;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file datagram_store.h
+ * @brief Persistent store-and-forward buffer for datagrams that could not be sent
+ *
+ * This header provides a circular log of encoded datagrams in the
+ * storage_partition of the internal flash, built on Zephyr's flash circular
+ * buffer (FCB). Datagrams are stored while the network or the collector is
+ * unreachable and replayed at a bounded rate once sending works again.
+ */
+
+#pragma once
+
+#include <zephyr/fs/fcb.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "udp_client.h"
+
+/**
+ * @brief Flash-backed FIFO of encoded datagrams with rate-limited backfill
+ *
+ * Writes are batched: datagrams are collected in a RAM page of
+ * CONFIG_APP_STORE_FORWARD_PAGE_SIZE bytes and the page is written as one
+ * FCB entry once it is full. This keeps the number of flash writes, and
+ * with it wear and write latency, at one per page instead of one per
+ * datagram. Inside a page every datagram is prefixed with its 16-bit
+ * length; a zero length ends the page. A partially filled page is lost on
+ * reset; once the flash is drained it is replayed straight from RAM.
+ *
+ * Stored datagrams keep their sequence numbers and are marked with
+ * kFlagBackfill. When the log is full the oldest flash sector is erased,
+ * i.e. the oldest stored datagrams are given up first. Backfill replays
+ * oldest first and sends at most CONFIG_APP_STORE_FORWARD_BURST datagrams per
+ * CONFIG_APP_STORE_FORWARD_BURST_INTERVAL_MS, so that replaying an outage
+ * never crowds out live traffic. A sector is erased once all of its pages
+ * were replayed. The read position is not persisted: pages of the newest,
+ * partially replayed sector may be sent again after a reboot. The host
+ * receiver recognizes them by sequence number and boot ID as long as they
+ * lie within its duplicate window (the last 1024 datagrams of each of the
+ * last four boots); older repeats are accepted and stored a second time.
+ *
+ * The store is not thread-safe; it is used by the transmit thread only.
+ *
+ * Usage example:
+ * @code
+ * DatagramStore store;
+ * store.init();
+ *
+ * if (client.send(buf, len) != SendResult::kOk) {
+ *     store.append(buf, len);
+ * }
+ * store.backfill(client, k_uptime_get());
+ * @endcode
+ */
+class DatagramStore {
+public:
+    /// Size of one page (FCB entry) in bytes
+    static constexpr size_t kPageSize = CONFIG_APP_STORE_FORWARD_PAGE_SIZE;
+
+    /// Size of the length prefix of a datagram inside a page
+    static constexpr size_t kRecordHeaderSize = 2;
+
+    /// Largest datagram that can be stored
+    static constexpr size_t kMaxDatagram = kPageSize - kRecordHeaderSize;
+
+    /**
+     * @brief Store statistics since start-up
+     */
+    struct Stats {
+        uint32_t stored;          ///< Datagrams appended
+        uint32_t backfilled;      ///< Datagrams replayed successfully
+        uint32_t rejected;        ///< Datagrams not stored (too large, store unavailable)
+        uint32_t pages_written;   ///< Pages written to flash
+        uint32_t overflows;       ///< Oldest sector erased to make room (data given up)
+    };
+
+    /**
+     * @brief Open the circular log on storage_partition
+     *
+     * Datagrams stored before a reboot are kept and replayed.
+     *
+     * @return true if the store is usable
+     * @return false if the partition could not be opened (datagrams are then rejected)
+     */
+    bool init();
+
+    /**
+     * @brief Queue a datagram that could not be sent
+     *
+     * The datagram is copied into the RAM page; a full page is written to
+     * flash first, which may erase the oldest sector.
+     *
+     * @param datagram Encoded datagram
+     * @param len      Datagram length in bytes (at most kMaxDatagram)
+     *
+     * @return true if the datagram was stored
+     */
+    bool append(const uint8_t* datagram, size_t len);
+
+    /**
+     * @brief Replay stored datagrams, at most one burst per burst interval
+     *
+     * Stops at the first datagram the client does not accept; that
+     * datagram is retried with the next burst.
+     *
+     * @param client UDP client to send with
+     * @param now    Current uptime in ms
+     *
+     * @return Number of datagrams replayed
+     */
+    size_t backfill(UdpClient& client, int64_t now);
+
+    /**
+     * @brief Check whether datagrams are waiting for backfill
+     */
+    inline bool pending() const {
+        return page_len_ > 0 || read_len_ > 0 || flash_pending_;
+    }
+
+    /**
+     * @brief Uptime (ms) at which backfill() sends the next burst
+     */
+    inline int64_t nextBurst() const {
+        return next_burst_;
+    }
+
+    /**
+     * @brief Get the store statistics
+     */
+    inline const Stats& stats() const {
+        return stats_;
+    }
+
+private:
+    /// Maximum number of flash sectors used by the log
+    static constexpr size_t kMaxSectors = CONFIG_APP_STORE_FORWARD_MAX_SECTORS;
+
+    struct fcb fcb_{};                          ///< Flash circular buffer
+    struct flash_sector sectors_[kMaxSectors]{}; ///< Sector table of storage_partition
+    struct fcb_entry read_loc_{};               ///< Last page read for backfill
+    bool ready_ = false;                        ///< init() succeeded
+    bool flash_pending_ = false;                ///< Flash holds pages not read yet
+
+    uint8_t page_[kPageSize]{};  ///< Page being filled
+    size_t page_len_ = 0;        ///< Bytes used in page_
+
+    uint8_t read_page_[kPageSize]{};  ///< Page being replayed
+    size_t read_len_ = 0;             ///< Valid bytes in read_page_, 0 if none loaded
+    size_t read_off_ = 0;             ///< Offset of the next datagram in read_page_
+
+    int64_t next_burst_ = 0;  ///< Uptime (ms) of the next backfill burst
+    Stats stats_{};           ///< Store statistics
+
+    /// Write page_ as one FCB entry, erasing the oldest sector if the log is full
+    bool writePage();
+
+    /// Load the next page from flash into read_page_
+    bool readPage();
+};
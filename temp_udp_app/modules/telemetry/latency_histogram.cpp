@@ -0,0 +1,70 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of the log2 latency histogram
+ */
+
+#include "latency_histogram.h"
+
+/**
+ * @brief Bucket index of a value
+ *
+ * @return 0 for 0, otherwise the bit width of @p value
+ */
+size_t LatencyHistogram::bucketOf(uint32_t value) {
+    return value == 0 ? 0 : 32 - static_cast<size_t>(__builtin_clz(value));
+}
+
+/**
+ * @brief Count one value
+ */
+void LatencyHistogram::record(uint32_t value) {
+    buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t prev = max_.load(std::memory_order_relaxed);
+    while (value > prev &&
+           !max_.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Estimate a percentile
+ *
+ * @return Upper bound of the bucket containing the percentile, at most max()
+ */
+uint32_t LatencyHistogram::percentile(unsigned percent) const {
+    uint32_t total = 0;
+    uint32_t counts[kBuckets];
+    for (size_t b = 0; b < kBuckets; ++b) {
+        counts[b] = buckets_[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the requested percentile, rounded up (nearest-rank method)
+    const uint64_t rank = (static_cast<uint64_t>(total) * percent + 99) / 100;
+    const uint32_t peak = max();
+    uint64_t seen = 0;
+
+    for (size_t b = 0; b < kBuckets; ++b) {
+        seen += counts[b];
+        if (seen >= rank && seen > 0) {
+            const uint64_t upper = b == 0 ? 0 : (static_cast<uint64_t>(1) << b) - 1;
+            return upper < peak ? static_cast<uint32_t>(upper) : peak;
+        }
+    }
+    return peak;
+}
+
+/**
+ * @brief Clear all buckets
+ */
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
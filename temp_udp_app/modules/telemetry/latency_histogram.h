@@ -0,0 +1,92 @@
+/**
+ * @file latency_histogram.h
+ * @brief Fixed-bucket log2 histogram for hot-path latency measurements
+ *
+ * This header provides a small, lock-free histogram that can be updated
+ * from any thread with a handful of instructions. It has no Zephyr
+ * dependencies; the unit of the recorded values (usually hardware cycles)
+ * is up to the caller.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Log2 histogram with a constant number of buckets
+ *
+ * Bucket 0 counts the value 0, bucket b (b >= 1) counts values in
+ * [2^(b-1), 2^b). Counters are 32 bits wide so that recording stays
+ * lock-free on Cortex-M. Recording is a count-leading-zeros plus two relaxed atomic
+ * increments and an occasional compare-exchange for the maximum, so it is
+ * cheap enough to stay enabled in production builds.
+ *
+ * Percentiles are reported as the upper bound of the bucket that contains
+ * them (clamped to the exact maximum), i.e. with a resolution of a factor
+ * of two. That is sufficient to tell a 20 us I2C transfer from a 2 ms
+ * stall.
+ *
+ * Usage example:
+ * @code
+ * static LatencyHistogram hist;
+ * uint32_t start = k_cycle_get_32();
+ * work();
+ * hist.record(k_cycle_get_32() - start);
+ * uint32_t p99 = hist.percentile(99);
+ * @endcode
+ */
+class LatencyHistogram {
+public:
+    /// Number of buckets; bucket 0 plus one per bit of a 32-bit value
+    static constexpr size_t kBuckets = 33;
+
+    /**
+     * @brief Count one value
+     *
+     * @param value Measured duration
+     */
+    void record(uint32_t value);
+
+    /**
+     * @brief Number of recorded values
+     */
+    inline uint32_t count() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Largest recorded value (exact)
+     */
+    inline uint32_t max() const {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Estimate a percentile
+     *
+     * @param percent Percentile in the range 0 to 100
+     *
+     * @return Upper bound of the bucket containing the percentile, at most
+     *         max(); 0 if nothing was recorded
+     */
+    uint32_t percentile(unsigned percent) const;
+
+    /**
+     * @brief Clear all buckets
+     *
+     * @note Values recorded concurrently with reset() may be partially lost
+     */
+    void reset();
+
+    /**
+     * @brief Bucket index of a value
+     */
+    static size_t bucketOf(uint32_t value);
+
+private:
+    std::atomic<uint32_t> buckets_[kBuckets] = {};  ///< Per-bucket counts
+    std::atomic<uint32_t> count_{0};                ///< Total number of values
+    std::atomic<uint32_t> max_{0};                  ///< Largest value
+};
@@ -0,0 +1,120 @@
+/**
+ * @file latency_stats.cpp
+ * @brief Stage histograms, loop period tracking and the "sensor stats" command
+ */
+
+#include "latency_stats.h"
+
+#include <zephyr/shell/shell.h>
+
+#include <errno.h>
+#include <cstring>
+
+/// One histogram per stage
+static LatencyHistogram stage_histograms[kStageCount];
+
+/// Display names, indexed by LatencyStage
+static const char* const stage_names[kStageCount] = {
+    "fetch", "chan_temp", "chan_hum", "cycle", "send", "period", "jitter",
+};
+
+LatencyHistogram& LatencyStats::histogram(LatencyStage stage) {
+    return stage_histograms[stage];
+}
+
+const char* LatencyStats::name(LatencyStage stage) {
+    return stage_names[stage];
+}
+
+void LatencyStats::reset() {
+    for (auto& hist : stage_histograms) {
+        hist.reset();
+    }
+}
+
+/**
+ * @brief Record the time since the previous call
+ *
+ * The first call only stores the reference point. Jitter is the absolute
+ * difference between two consecutive periods.
+ */
+void LoopPeriodTracker::tick() {
+    const uint32_t cycles = k_cycle_get_32();
+    const int64_t ticks = k_uptime_ticks();
+
+    if (started_) {
+        uint64_t period_us = k_ticks_to_us_floor64(ticks - last_ticks_);
+
+        // The 32-bit cycle counter is exact but wraps; use it well inside its range
+        if (period_us < k_cyc_to_us_floor64(UINT32_MAX) / 2) {
+            period_us = k_cyc_to_us_floor64(cycles - last_cycles_);
+        }
+        const uint32_t period = period_us < UINT32_MAX ? static_cast<uint32_t>(period_us)
+                                                       : UINT32_MAX;
+
+        LatencyStats::record(kStageLoopPeriod, period);
+        if (have_period_) {
+            const uint32_t jitter = period > last_period_us_ ? period - last_period_us_
+                                                             : last_period_us_ - period;
+            LatencyStats::record(kStageLoopJitter, jitter);
+        }
+        last_period_us_ = period;
+        have_period_ = true;
+    }
+
+    last_cycles_ = cycles;
+    last_ticks_ = ticks;
+    started_ = true;
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief Convert a recorded value to nanoseconds
+ */
+static uint64_t toNs(LatencyStage stage, uint32_t value) {
+    return LatencyStats::inCycles(stage) ? k_cyc_to_ns_floor64(value)
+                                         : static_cast<uint64_t>(value) * NSEC_PER_USEC;
+}
+
+/**
+ * @brief Print a duration in microseconds with one decimal place
+ */
+static void printUs(const struct shell* sh, uint64_t ns) {
+    shell_fprintf(sh, SHELL_NORMAL, " %10llu.%01llu", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>((ns % 1000) / 100));
+}
+
+/**
+ * @brief "sensor stats [reset]" - print or clear the stage histograms
+ */
+static int cmd_sensor_stats(const struct shell* sh, size_t argc, char** argv) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(sh, "Unknown argument: %s", argv[1]);
+            return -EINVAL;
+        }
+        LatencyStats::reset();
+        shell_print(sh, "Latency statistics cleared");
+        return 0;
+    }
+
+    shell_print(sh, "%-10s %10s %12s %12s %12s", "stage", "count", "p50 [us]", "p99 [us]",
+                "max [us]");
+    for (uint8_t s = 0; s < kStageCount; ++s) {
+        const LatencyStage stage = static_cast<LatencyStage>(s);
+        const LatencyHistogram& hist = LatencyStats::histogram(stage);
+
+        shell_fprintf(sh, SHELL_NORMAL, "%-10s %10u", LatencyStats::name(stage), hist.count());
+        printUs(sh, toNs(stage, hist.percentile(50)));
+        printUs(sh, toNs(stage, hist.percentile(99)));
+        printUs(sh, toNs(stage, hist.max()));
+        shell_fprintf(sh, SHELL_NORMAL, "\n");
+    }
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), stats, NULL,
+                 "Hot-path latency p50/p99/max per stage\n"
+                 "Usage: sensor stats [reset]",
+                 cmd_sensor_stats, 1, 1);
+#endif
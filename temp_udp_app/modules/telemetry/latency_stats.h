@@ -0,0 +1,128 @@
+/**
+ * @file latency_stats.h
+ * @brief Per-stage latency instrumentation of the sampling and transmit paths
+ *
+ * This header names the hot-path stages that are measured (sensor fetch,
+ * channel reads, transmission, loop period) and provides the helpers used
+ * to time them. With CONFIG_APP_LATENCY_STATS disabled all helpers are
+ * empty inline functions and compile to nothing.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstdint>
+
+#include "latency_histogram.h"
+
+/**
+ * @brief Measured stages
+ *
+ * Stages up to kStageSend are recorded in hardware cycles, the loop
+ * period stages in microseconds.
+ */
+enum LatencyStage : uint8_t {
+    kStageFetch = 0,          ///< sensor_sample_fetch() or the direct I2C measurement
+    kStageChannelTemperature, ///< sensor_channel_get(SENSOR_CHAN_AMBIENT_TEMP)
+    kStageChannelHumidity,    ///< sensor_channel_get(SENSOR_CHAN_HUMIDITY)
+    kStageSensorCycle,        ///< MultiSensorHandler::update() for all sensors
+    kStageSend,               ///< zsock_send() in UdpClient::send()
+    kStageLoopPeriod,         ///< Time between two sampling loop iterations
+    kStageLoopJitter,         ///< Change of the loop period between iterations
+    kStageCount
+};
+
+#if defined(CONFIG_APP_LATENCY_STATS)
+
+/**
+ * @brief Registry of one LatencyHistogram per stage
+ *
+ * The histograms are statically allocated and can be updated from any
+ * thread. The "sensor stats" shell command prints p50/p99/max per stage.
+ */
+class LatencyStats {
+public:
+    /// Get the histogram of a stage
+    static LatencyHistogram& histogram(LatencyStage stage);
+
+    /// Get the short display name of a stage
+    static const char* name(LatencyStage stage);
+
+    /// Check whether a stage is recorded in cycles (otherwise microseconds)
+    static inline bool inCycles(LatencyStage stage) {
+        return stage < kStageLoopPeriod;
+    }
+
+    /// Count one measurement of a stage
+    static inline void record(LatencyStage stage, uint32_t value) {
+        histogram(stage).record(value);
+    }
+
+    /// Clear all histograms
+    static void reset();
+};
+
+/**
+ * @brief Measures the cycles from construction to destruction
+ *
+ * Usage example:
+ * @code
+ * {
+ *     ScopedLatency measure(kStageSend);
+ *     zsock_send(...);
+ * }
+ * @endcode
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyStage stage) : stage_(stage), start_(k_cycle_get_32()) {
+    }
+
+    ~ScopedLatency() {
+        LatencyStats::record(stage_, k_cycle_get_32() - start_);
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyStage stage_;  ///< Stage to record into
+    uint32_t start_;      ///< Cycle counter at construction
+};
+
+/**
+ * @brief Records period and cycle-to-cycle jitter of a periodic loop
+ *
+ * Call tick() once per iteration at the same point of the loop. Periods
+ * are measured with the cycle counter as long as it cannot wrap and with
+ * the system tick counter beyond that.
+ */
+class LoopPeriodTracker {
+public:
+    /// Record the time since the previous call
+    void tick();
+
+private:
+    bool started_ = false;        ///< At least one tick was seen
+    bool have_period_ = false;    ///< last_period_us_ is valid
+    uint32_t last_cycles_ = 0;    ///< Cycle counter at the previous tick
+    int64_t last_ticks_ = 0;      ///< System ticks at the previous tick
+    uint32_t last_period_us_ = 0; ///< Previous period
+};
+
+#else
+
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyStage) {
+    }
+};
+
+class LoopPeriodTracker {
+public:
+    inline void tick() {
+    }
+};
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file sample_log.cpp
+ * @brief Implementation of the rate-limited sample summary
+ */
+
+#include "sample_log.h"
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(sample_log);
+
+/**
+ * @brief Constructor
+ */
+SampleLog::SampleLog(uint32_t interval_ms) : interval_ms_(interval_ms) {
+}
+
+/**
+ * @brief Store the latest value and count the sample
+ */
+void SampleLog::record(const SensorData& sample) {
+    if (sample.sensor >= SensorProtocol::kMaxSensors) {
+        return;
+    }
+
+    Entry& entry = entries_[sample.sensor];
+    entry.temperature = SensorProtocol::toCentiCelsius(sample.temperature);
+    entry.humidity = SensorProtocol::toCentiPercent(sample.humidity);
+    entry.samples++;
+}
+
+/**
+ * @brief Log one line per active sensor once per interval
+ *
+ * Values are printed from their fixed-point form; the sign is passed
+ * separately so that -0.05 is not printed as 0.05.
+ */
+void SampleLog::poll(int64_t now) {
+    if (interval_ms_ == 0 || now < next_) {
+        return;
+    }
+    next_ = now + interval_ms_;
+
+    for (uint8_t i = 0; i < SensorProtocol::kMaxSensors; ++i) {
+        Entry& entry = entries_[i];
+        if (entry.samples == 0) {
+            continue;
+        }
+
+        const int32_t t = entry.temperature;
+        const uint32_t t_abs = static_cast<uint32_t>(t < 0 ? -t : t);
+        LOG_INF("Sensor %u: %s%u.%02u deg, %u.%02u %% (%u samples)", i, t < 0 ? "-" : "",
+                t_abs / 100, t_abs % 100, entry.humidity / 100, entry.humidity % 100,
+                entry.samples);
+        entry.samples = 0;
+    }
+}
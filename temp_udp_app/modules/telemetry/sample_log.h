@@ -0,0 +1,73 @@
+/**
+ * @file sample_log.h
+ * @brief Rate-limited log summary of the received samples
+ *
+ * This header provides the replacement for logging every sample: the
+ * transmit thread records each sample and one line per sensor is logged
+ * once per CONFIG_APP_LOG_SUMMARY_INTERVAL_MS. The log volume therefore no
+ * longer grows with the sampling rate.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "sensor_handler.h"
+#include "sensor_protocol.h"
+
+/**
+ * @brief Periodic per-sensor summary (latest value and sample count)
+ *
+ * record() only stores the sample in fixed-point form and increments a
+ * counter; formatting happens in poll() at most once per interval, with
+ * integer arguments only, so the summary also works with dictionary
+ * logging and without floating point support in cbprintf.
+ *
+ * Usage example:
+ * @code
+ * SampleLog sample_log(10000);
+ *
+ * while (ring.pop(sample)) {
+ *     sample_log.record(sample);
+ * }
+ * sample_log.poll(k_uptime_get());
+ * @endcode
+ */
+class SampleLog {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param interval_ms Time between two summaries, 0 disables them
+     */
+    explicit SampleLog(uint32_t interval_ms);
+
+    /**
+     * @brief Account one sample
+     *
+     * @param sample Sample taken from the sample ring
+     */
+    void record(const SensorData& sample);
+
+    /**
+     * @brief Log the summary if the interval elapsed
+     *
+     * Sensors without samples in the interval are skipped; the counters
+     * restart after every summary.
+     *
+     * @param now Current uptime in ms
+     */
+    void poll(int64_t now);
+
+private:
+    /// Latest sample and count of one sensor
+    struct Entry {
+        int16_t temperature;  ///< Latest temperature in 0.01 degrees Celsius
+        uint16_t humidity;    ///< Latest humidity in 0.01 %RH
+        uint32_t samples;     ///< Samples since the last summary
+    };
+
+    uint32_t interval_ms_;                          ///< Summary interval
+    int64_t next_ = 0;                              ///< Uptime of the next summary
+    Entry entries_[SensorProtocol::kMaxSensors]{};  ///< Per-sensor state
+};
@@ -0,0 +1,15 @@
+/**
+ * @file sensor_shell.cpp
+ * @brief Root of the "sensor" shell command
+ *
+ * Modules add their subcommands with
+ * SHELL_SUBCMD_ADD((sensor), <name>, ...) in their own translation unit,
+ * so the command tree grows without a central list. The root replaces
+ * Zephyr's generic sensor shell (CONFIG_SENSOR_SHELL), which would
+ * register the same name.
+ */
+
+#include <zephyr/shell/shell.h>
+
+SHELL_SUBCMD_SET_CREATE(sensor_cmds, (sensor));
+SHELL_CMD_REGISTER(sensor, &sensor_cmds, "SHT31 application commands", NULL);
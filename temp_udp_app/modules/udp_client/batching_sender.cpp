@@ -0,0 +1,259 @@
+/**
+ * @file batching_sender.cpp
+ * @brief Implementation of the multi-sample UDP batching layer
+ *
+ * This file implements the BatchingSender class which groups several
+ * SensorData samples into a single UDP datagram encoded with the
+ * versioned SensorProtocol wire format.
+ */
+
+#include "batching_sender.h"
+
+#include <zephyr/logging/log.h>
+
+#include "device_clock.h"
+
+#if defined(CONFIG_APP_STORE_FORWARD)
+#include "datagram_store.h"
+#endif
+
+LOG_MODULE_REGISTER(batching_sender);
+
+/// Number of datagrams between two statistics log lines
+static constexpr uint32_t kStatsLogInterval = 64;
+
+/**
+ * @brief Constructor - bind the batching layer to a UDP client
+ *
+ * @param client UDP client used for transmission
+ * @param store  Store for datagrams that could not be sent, nullptr to drop them
+ */
+BatchingSender::BatchingSender(UdpClient& client, DatagramStore* store)
+    : client_(client), store_(store) {
+#if defined(CONFIG_APP_STORE_FORWARD)
+    static_assert(kBufferSize <= DatagramStore::kMaxDatagram,
+                  "CONFIG_APP_STORE_FORWARD_PAGE_SIZE too small for a full batch");
+#endif
+    LOG_INF("Batching up to %u samples, max latency %d ms",
+            static_cast<unsigned>(kMaxSamples), CONFIG_APP_UDP_BATCH_MAX_LATENCY_MS);
+}
+
+/**
+ * @brief Append a sample to the pending batch
+ *
+ * The flush deadline is armed by the first sample of a batch so that no
+ * sample waits longer than CONFIG_APP_UDP_BATCH_MAX_LATENCY_MS, unless
+ * pacing holds the batch back.
+ *
+ * @param sample Sensor sample to append
+ *
+ * @return SendResult::kOk if the sample was queued and any triggered flush succeeded
+ * @return Result of the triggered flush otherwise
+ */
+SendResult BatchingSender::add(const SensorData& sample) {
+    if (count_ == 0) {
+        deadline_ = k_uptime_get() + CONFIG_APP_UDP_BATCH_MAX_LATENCY_MS;
+    }
+
+    WireSample& wire = samples_[count_++];
+    wire.temperature = SensorProtocol::toCentiCelsius(sample.temperature);
+    wire.humidity = SensorProtocol::toCentiPercent(sample.humidity);
+    wire.timestamp_us = sample.timestamp_us;
+    wire.sequence = sample.sequence;
+    wire.sensor = sample.sensor;
+
+    // Flush as soon as the batch is full or no batching delay is allowed
+    if (count_ >= kMaxSamples ||
+        (CONFIG_APP_UDP_BATCH_MAX_LATENCY_MS == 0 && k_uptime_get() >= deadline())) {
+        return flush();
+    }
+    return SendResult::kOk;
+}
+
+/**
+ * @brief Flush the pending batch if its deadline expired
+ *
+ * @return SendResult::kOk if nothing had to be sent or the flush succeeded
+ * @return Result of the failed flush otherwise
+ */
+SendResult BatchingSender::poll() {
+    if (count_ > 0 && k_uptime_get() >= deadline()) {
+        return flush();
+    }
+    return SendResult::kOk;
+}
+
+/**
+ * @brief Transmit all pending samples as one datagram
+ *
+ * Only the used part of the frame is transmitted. The sequence number is
+ * advanced for every attempted datagram so that the receiver can detect
+ * lost batches, including those dropped locally.
+ *
+ * @return SendResult::kOk if the batch was empty or was transmitted successfully
+ * @return SendResult::kWouldBlock or kError if it was dropped
+ */
+SendResult BatchingSender::flush() {
+    if (count_ == 0) {
+        return SendResult::kOk;
+    }
+
+    const WirePacketHeader header = nextHeader();
+    const size_t len = encode(header);
+    const SendResult result = transmit(len);
+    last_send_ = k_uptime_get();
+
+    if (result == SendResult::kOk) {
+        LOG_DBG("Batch %u transmitted: %zu samples, %zu bytes", header.sequence, count_, len);
+    } else {
+        LOG_DBG("Batch %u dropped: %zu samples", header.sequence, count_);
+    }
+
+    // Start a new batch regardless of the result; UDP has no retransmission
+    count_ = 0;
+    return result;
+}
+
+/**
+ * @brief Transmit window summaries immediately
+ *
+ * Pending samples are not affected; in aggregation mode no samples are
+ * queued at all.
+ *
+ * @return SendResult::kOk if all datagrams were transmitted successfully
+ * @return The first failure otherwise
+ */
+SendResult BatchingSender::sendAggregates(const WireAggregate* aggregates, size_t count) {
+    SendResult first_failure = SendResult::kOk;
+
+    while (count > 0) {
+        const size_t n = count < kMaxAggregates ? count : kMaxAggregates;
+
+        const WirePacketHeader header = nextHeader();
+        const size_t len =
+            SensorProtocol::encodeAggregates(header, aggregates, n, buffer_, sizeof(buffer_));
+        const SendResult result = transmit(len);
+        if (result == SendResult::kOk) {
+            LOG_DBG("Summary datagram %u transmitted: %zu windows", header.sequence, n);
+        } else {
+            LOG_DBG("Summary datagram %u dropped: %zu windows", header.sequence, n);
+            if (first_failure == SendResult::kOk) {
+                first_failure = result;
+            }
+        }
+
+        aggregates += n;
+        count -= n;
+    }
+    return first_failure;
+}
+
+/**
+ * @brief Fill the header fields owned by the sender
+ *
+ * Takes the next datagram sequence number and the current clock offset;
+ * the offset is only flagged as valid once DeviceClock is synced.
+ *
+ * @return Header with device_id, boot_id, sequence, flags and clock_offset set
+ */
+WirePacketHeader BatchingSender::nextHeader() {
+    WirePacketHeader header{};
+    header.device_id = CONFIG_APP_DEVICE_ID;
+    header.boot_id = DeviceClock::bootId();
+    header.sequence = sequence_++;
+    if (DeviceClock::synced()) {
+        header.flags |= kFlagClockSynced;
+        header.clock_offset = DeviceClock::offsetUs();
+    }
+    return header;
+}
+
+/**
+ * @brief Hand an encoded datagram to the UDP client
+ *
+ * Dropped datagrams are only counted here; they are reported with the
+ * periodic statistics so that a congested network does not additionally
+ * flood the log. With a store attached they are kept for backfill.
+ *
+ * @param len Datagram length in buffer_, 0 after an encoder error
+ *
+ * @return SendResult Outcome of the transmission attempt
+ */
+SendResult BatchingSender::transmit(size_t len) {
+    const SendResult result = len > 0 ? client_.send(buffer_, len) : SendResult::kError;
+
+    if (result == SendResult::kWouldBlock) {
+        stats_.would_block++;
+    } else if (result == SendResult::kError) {
+        stats_.errors++;
+    }
+
+#if defined(CONFIG_APP_STORE_FORWARD)
+    if (result != SendResult::kOk && len > 0 && store_ != nullptr) {
+        store_->append(buffer_, len);
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief Encode the pending samples into the datagram buffer
+ *
+ * The compressed encoding is only used if it is strictly smaller than the
+ * plain one; its capacity is limited accordingly, so a poorly compressible
+ * batch aborts early and falls back to the plain fixed-point records.
+ *
+ * @param header Header fields (device_id, sequence)
+ *
+ * @return Datagram length in bytes, 0 on encoder error
+ */
+size_t BatchingSender::encode(const WirePacketHeader& header) {
+    const size_t plain_len = SensorProtocol::encodedSize(count_);
+    const uint32_t start = k_cycle_get_32();
+
+    size_t len = 0;
+#if defined(CONFIG_APP_UDP_BATCH_COMPRESSION)
+    len = SensorProtocol::encodeCompressed(header, samples_, count_, buffer_, plain_len - 1);
+#endif
+    if (len == 0) {
+        len = SensorProtocol::encode(header, samples_, count_, buffer_, sizeof(buffer_));
+    }
+
+    stats_.encode_cycles += k_cycle_get_32() - start;
+    stats_.datagrams++;
+    stats_.samples += count_;
+    stats_.plain_bytes += plain_len;
+    stats_.wire_bytes += len;
+
+    if (stats_.datagrams % kStatsLogInterval == 0) {
+        logStats();
+    }
+    return len;
+}
+
+/**
+ * @brief Log compression ratio, encode cost and dropped datagrams
+ *
+ * The ratio is given as wire size relative to the plain fixed-point
+ * encoding; the cost is the average encoder time per sample.
+ */
+void BatchingSender::logStats() const {
+    if (stats_.samples == 0 || stats_.plain_bytes == 0) {
+        return;
+    }
+
+    const uint32_t percent = static_cast<uint32_t>(stats_.wire_bytes * 100 / stats_.plain_bytes);
+    const uint32_t bytes_per_sample_x100 =
+        static_cast<uint32_t>(stats_.wire_bytes * 100 / stats_.samples);
+    const uint32_t ns_per_sample =
+        static_cast<uint32_t>(k_cyc_to_ns_floor64(stats_.encode_cycles) / stats_.samples);
+
+    LOG_INF("Encoder: %u datagrams, wire size %u%% of plain, %u.%02u bytes/sample, %u ns/sample",
+            stats_.datagrams, percent, bytes_per_sample_x100 / 100, bytes_per_sample_x100 % 100,
+            ns_per_sample);
+
+    if (stats_.would_block > 0 || stats_.errors > 0) {
+        LOG_WRN("Dropped datagrams: %u back-pressure, %u errors", stats_.would_block,
+                stats_.errors);
+    }
+}
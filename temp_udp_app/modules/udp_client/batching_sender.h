@@ -0,0 +1,222 @@
+/**
+ * @file batching_sender.h
+ * @brief Multi-sample UDP batching on top of UdpClient
+ *
+ * This header provides a small batching layer that collects several
+ * SensorData samples and transmits them as a single UDP datagram. This
+ * keeps the packet rate constant while the sampling rate increases.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "sensor_handler.h"
+#include "sensor_protocol.h"
+#include "udp_client.h"
+
+class DatagramStore;
+
+/**
+ * @brief Collects samples and flushes them as one UDP datagram
+ *
+ * A batch is flushed when CONFIG_APP_UDP_BATCH_SIZE samples are pending
+ * or when the oldest pending sample has waited longer than
+ * CONFIG_APP_UDP_BATCH_MAX_LATENCY_MS. Samples are converted to fixed-point
+ * when queued and the datagram is encoded with SensorProtocol, carrying
+ * CONFIG_APP_DEVICE_ID, the boot ID, a per-datagram sequence number and
+ * the SNTP clock offset of DeviceClock.
+ *
+ * Transmission results are passed through as SendResult. A datagram the
+ * network stack refuses for lack of buffers (SendResult::kWouldBlock) is
+ * dropped rather than retried, so the caller never waits; its sequence
+ * number shows up as a gap at the receiver. With a DatagramStore attached,
+ * every datagram that could not be sent is stored for later backfill
+ * instead.
+ *
+ * setMinInterval() paces the datagrams: a partial batch is held back until
+ * the interval since the previous datagram has passed, so it keeps growing
+ * instead. A full batch is always sent.
+ *
+ * With CONFIG_APP_UDP_BATCH_COMPRESSION the payload is compressed with
+ * SampleCodec whenever that is smaller than the plain encoding. Compression
+ * ratio and encode cost are tracked in Stats and logged periodically.
+ *
+ * Usage example:
+ * @code
+ * UdpClient client("192.168.1.37", 8888);
+ * BatchingSender sender(client);
+ *
+ * if (sensor.update()) {
+ *     sender.add(sensor.getData());  // Flushes automatically when full
+ * }
+ * if (sender.poll() == SendResult::kWouldBlock) {  // Flushes when the deadline expired
+ *     // Network stack congested, the batch was dropped
+ * }
+ * @endcode
+ */
+class BatchingSender {
+public:
+    /// Maximum number of samples per datagram
+    static constexpr size_t kMaxSamples = CONFIG_APP_UDP_BATCH_SIZE;
+    static_assert(kMaxSamples <= SensorProtocol::kMaxSamples, "Batch exceeds protocol limit");
+
+    /// Maximum number of window summaries per datagram
+    static constexpr size_t kMaxAggregates = 8;
+
+    /**
+     * @brief Encoder statistics since start-up
+     */
+    struct Stats {
+        uint32_t datagrams;      ///< Number of encoded datagrams
+        uint32_t samples;        ///< Number of encoded samples
+        uint64_t plain_bytes;    ///< Bytes the plain fixed-point encoding would have used
+        uint64_t wire_bytes;     ///< Bytes actually handed to the UDP client
+        uint64_t encode_cycles;  ///< CPU cycles spent in the encoder
+        uint32_t would_block;    ///< Datagrams dropped because of back-pressure
+        uint32_t errors;         ///< Datagrams dropped because of send errors
+    };
+
+    /**
+     * @brief Constructor - bind the batching layer to a UDP client
+     *
+     * @param client UDP client used for transmission (must outlive the sender)
+     * @param store  Store for datagrams that could not be sent, nullptr to drop them
+     */
+    explicit BatchingSender(UdpClient& client, DatagramStore* store = nullptr);
+
+    /**
+     * @brief Append a sample to the pending batch
+     *
+     * The batch is flushed immediately when it becomes full or when the
+     * configured maximum latency is zero.
+     *
+     * @param sample Sensor sample to append
+     *
+     * @return SendResult::kOk if the sample was queued (and any triggered flush succeeded)
+     * @return Result of the triggered flush otherwise (the batch is dropped)
+     */
+    SendResult add(const SensorData& sample);
+
+    /**
+     * @brief Flush the pending batch if its deadline expired
+     *
+     * Should be called periodically, e.g. once per sampling cycle.
+     *
+     * @return SendResult::kOk if nothing had to be sent or the flush succeeded
+     * @return Result of the failed flush otherwise
+     */
+    SendResult poll();
+
+    /**
+     * @brief Transmit all pending samples as one datagram
+     *
+     * @return SendResult::kOk if the batch was empty or was transmitted successfully
+     * @return SendResult::kWouldBlock or kError if it was dropped
+     */
+    SendResult flush();
+
+    /**
+     * @brief Transmit window summaries immediately
+     *
+     * Summaries are sent as kPacketAggregates datagrams of up to
+     * kMaxAggregates records. They share the sequence number space with
+     * sample batches, so the receiver's loss detection covers both.
+     *
+     * @param aggregates Summaries ordered by window start
+     * @param count      Number of summaries
+     *
+     * @return SendResult::kOk if all datagrams were transmitted successfully
+     * @return The first failure otherwise (later datagrams are still attempted)
+     */
+    SendResult sendAggregates(const WireAggregate* aggregates, size_t count);
+
+    /**
+     * @brief Set the minimum interval between two datagrams
+     *
+     * Used by CongestionController to lower the datagram rate; applies to
+     * partial batches only. Summary datagrams are not paced.
+     *
+     * @param interval_ms Minimum interval in ms, 0 disables pacing
+     */
+    inline void setMinInterval(uint32_t interval_ms) {
+        min_interval_ms_ = interval_ms;
+    }
+
+    /**
+     * @brief Get the number of samples waiting in the current batch
+     */
+    inline size_t pending() const {
+        return count_;
+    }
+
+    /**
+     * @brief Get the point in time at which poll() has to flush
+     *
+     * Suitable as timeout for blocking waits in the transmitting thread.
+     *
+     * @return K_FOREVER if no sample is pending, the absolute flush deadline otherwise
+     */
+    inline k_timeout_t nextDeadline() const {
+        return count_ == 0 ? K_FOREVER : K_TIMEOUT_ABS_MS(deadline());
+    }
+
+    /**
+     * @brief Get the flush deadline as uptime in ms
+     *
+     * The latency deadline of the batch, postponed by the pacing interval
+     * if the previous datagram was sent too recently.
+     *
+     * @return INT64_MAX if no sample is pending
+     */
+    inline int64_t deadline() const {
+        return count_ == 0 ? INT64_MAX : std::max(deadline_, last_send_ + min_interval_ms_);
+    }
+
+    /**
+     * @brief Get the sequence number the next datagram will carry
+     */
+    inline uint32_t sequence() const {
+        return sequence_;
+    }
+
+    /**
+     * @brief Get the encoder statistics (compression ratio, encode cost)
+     */
+    inline const Stats& stats() const {
+        return stats_;
+    }
+
+private:
+    /// Datagram buffer size, large enough for a sample batch or a summary datagram
+    static constexpr size_t kBufferSize =
+        std::max(SensorProtocol::encodedSize(kMaxSamples),
+                 SensorProtocol::aggregateEncodedSize(kMaxAggregates));
+
+    UdpClient& client_;                       ///< Underlying UDP transport
+    DatagramStore* store_;                    ///< Store-and-forward buffer, may be nullptr
+    WireSample samples_[kMaxSamples]{};       ///< Pending samples in fixed-point form
+    uint8_t buffer_[kBufferSize]{};           ///< Encoded datagram
+    size_t count_ = 0;     ///< Number of samples in samples_
+    uint32_t sequence_ = 0; ///< Sequence number of the next datagram
+    int64_t deadline_ = 0; ///< Uptime (ms) at which the pending batch must be flushed
+    int64_t last_send_ = 0;         ///< Uptime (ms) of the previous datagram
+    uint32_t min_interval_ms_ = 0;  ///< Pacing interval between two datagrams
+    Stats stats_{};        ///< Encoder statistics
+
+    /// Header of the next datagram: device and boot ID, sequence, clock offset
+    WirePacketHeader nextHeader();
+
+    /// Encode the pending samples into buffer_, returns the datagram length
+    size_t encode(const WirePacketHeader& header);
+
+    /// Hand len bytes of buffer_ to the client and count a refused datagram
+    SendResult transmit(size_t len);
+
+    /// Log compression ratio, encode cost and dropped datagrams
+    void logStats() const;
+};
@@ -0,0 +1,177 @@
+/**
+ * @file congestion_controller.cpp
+ * @brief Implementation of the AIMD send pacing and "sensor congestion"
+ */
+
+#include "congestion_controller.h"
+
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_pkt.h>
+
+#if defined(CONFIG_NET_STATISTICS_USER_API)
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#endif
+
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+#include <errno.h>
+#include <cstring>
+#endif
+
+LOG_MODULE_REGISTER(congestion);
+
+/// Free TX packets below which an epoch counts as congested
+static constexpr uint32_t kTxFreeThreshold = CONFIG_NET_PKT_TX_COUNT / 4;
+
+/// Controller shown by the shell
+static CongestionController* shell_instance;
+
+/**
+ * @brief Constructor - start at the maximum rate, the first epoch starts now
+ */
+CongestionController::CongestionController(const UdpClient& client)
+    : client_(client),
+      rate_(CONFIG_APP_CONGESTION_MAX_RATE),
+      tx_free_low_(CONFIG_NET_PKT_TX_COUNT),
+      tx_free_last_(CONFIG_NET_PKT_TX_COUNT) {
+    last_drops_ = stackDrops();
+    shell_instance = this;
+}
+
+CongestionController* CongestionController::instance() {
+    return shell_instance;
+}
+
+/**
+ * @brief Sample the congestion signals and adapt the rate at epoch ends
+ *
+ * The rate is halved at most once per epoch, so a single burst of refused
+ * datagrams costs one halving, not one per datagram. Rate changes are
+ * logged at debug level only; "sensor congestion" shows the current state.
+ */
+void CongestionController::update(int64_t now) {
+    const uint32_t tx_free = txFree();
+    if (tx_free < tx_free_low_) {
+        tx_free_low_ = tx_free;
+    }
+
+    if (now < epoch_end_) {
+        return;
+    }
+    epoch_end_ = now + CONFIG_APP_CONGESTION_EPOCH_MS;
+
+    const UdpClient::Stats& sent = client_.stats();
+    const uint32_t would_block = sent.would_block - last_would_block_;
+    const uint32_t errors = sent.errors - last_errors_;
+    const uint32_t drops_now = stackDrops();
+    const uint32_t drops = drops_now - last_drops_;
+    const bool low_buffers = tx_free_low_ < kTxFreeThreshold;
+    const bool send_failed = would_block > 0 || errors > 0;
+
+    last_would_block_ = sent.would_block;
+    last_errors_ = sent.errors;
+    last_drops_ = drops_now;
+    tx_free_last_ = tx_free_low_;
+    tx_free_low_ = tx_free;
+
+    stats_.epochs++;
+    stats_.would_block += would_block;
+    stats_.errors += errors;
+    if (send_failed) {
+        // Drops without a local send failure are mostly received traffic
+        stats_.stack_drops += drops;
+    }
+    if (low_buffers) {
+        stats_.low_buffers++;
+    }
+
+    congested_ = send_failed || low_buffers;
+    if (congested_) {
+        // Multiplicative decrease
+        stats_.congested_epochs++;
+        rate_ = rate_ / 2 > CONFIG_APP_CONGESTION_MIN_RATE ? rate_ / 2
+                                                           : CONFIG_APP_CONGESTION_MIN_RATE;
+        LOG_DBG("Congested (%u refused, %u errors, %u drops, %u TX free): %u datagrams/s",
+                would_block, errors, send_failed ? drops : 0, tx_free_last_, rate_);
+    } else if (rate_ < CONFIG_APP_CONGESTION_MAX_RATE) {
+        // Additive increase
+        rate_ = rate_ + CONFIG_APP_CONGESTION_INCREASE < CONFIG_APP_CONGESTION_MAX_RATE
+                    ? rate_ + CONFIG_APP_CONGESTION_INCREASE
+                    : CONFIG_APP_CONGESTION_MAX_RATE;
+        LOG_DBG("Clear: %u datagrams/s", rate_);
+    }
+}
+
+void CongestionController::resetStats() {
+    stats_ = {};
+}
+
+/**
+ * @brief Read the sum of the IPv4 and UDP drop counters
+ *
+ * Both counters also count dropped received packets, e.g. every datagram
+ * to a port nobody listens on (LAN broadcast, mDNS). They are therefore no
+ * congestion signal of their own and only reported next to a local send
+ * failure.
+ */
+uint32_t CongestionController::stackDrops() {
+#if defined(CONFIG_NET_STATISTICS_USER_API)
+    struct net_stats stats;
+    if (net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats, sizeof(stats)) == 0) {
+        return stats.ipv4.drop + stats.udp.drop;
+    }
+#endif
+    return 0;
+}
+
+uint32_t CongestionController::txFree() {
+    struct k_mem_slab* rx;
+    struct k_mem_slab* tx;
+    struct net_buf_pool* rx_data;
+    struct net_buf_pool* tx_data;
+    net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
+    return k_mem_slab_num_free_get(tx);
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief "sensor congestion [reset]" - print or clear the controller state
+ */
+static int cmd_sensor_congestion(const struct shell* sh, size_t argc, char** argv) {
+    CongestionController* controller = CongestionController::instance();
+    if (controller == nullptr) {
+        shell_error(sh, "No congestion controller running");
+        return -ENODEV;
+    }
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(sh, "Unknown argument: %s", argv[1]);
+            return -EINVAL;
+        }
+        controller->resetStats();
+        shell_print(sh, "Congestion statistics cleared");
+        return 0;
+    }
+
+    const CongestionController::Stats& stats = controller->stats();
+    shell_print(sh, "state:       %s", controller->congested() ? "congested" : "clear");
+    shell_print(sh, "rate:        %u datagrams/s (%u..%u), min interval %u ms",
+                controller->rate(), CONFIG_APP_CONGESTION_MIN_RATE,
+                CONFIG_APP_CONGESTION_MAX_RATE, controller->interval());
+    shell_print(sh, "TX packets:  %u of %u free (lowest in last epoch)", controller->txFreeLow(),
+                CONFIG_NET_PKT_TX_COUNT);
+    shell_print(sh, "epochs:      %u, %u congested (%u ms each)", stats.epochs,
+                stats.congested_epochs, CONFIG_APP_CONGESTION_EPOCH_MS);
+    shell_print(sh, "signals:     %u refused, %u errors, %u low-buffer epochs, %u stack drops",
+                stats.would_block, stats.errors, stats.low_buffers, stats.stack_drops);
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), congestion, NULL,
+                 "AIMD send rate, TX buffer level and congestion signals\n"
+                 "Usage: sensor congestion [reset]",
+                 cmd_sensor_congestion, 1, 1);
+#endif
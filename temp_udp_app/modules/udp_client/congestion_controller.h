@@ -0,0 +1,152 @@
+/**
+ * @file congestion_controller.h
+ * @brief AIMD send pacing driven by network stack back-pressure
+ *
+ * This header provides a controller that watches the send results of a
+ * UdpClient and the free TX packets of the network stack, and derives
+ * the datagram rate the transmit thread may use.
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstdint>
+
+#include "udp_client.h"
+
+/**
+ * @brief Additive-increase / multiplicative-decrease datagram rate control
+ *
+ * The controller works in epochs of CONFIG_APP_CONGESTION_EPOCH_MS. An
+ * epoch is congested if any of the following happened during it:
+ * - UdpClient refused a datagram (SendResult::kWouldBlock) or failed to send
+ * - the free TX packets (CONFIG_NET_PKT_TX_COUNT) dropped below a quarter
+ *
+ * Only transmit pressure counts. The IPv4/UDP drop counters of the stack
+ * (CONFIG_NET_STATISTICS_USER_API) also grow for received packets nobody
+ * listens for, so they are only recorded for epochs with a local send
+ * failure, as a hint at where the datagrams were lost.
+ *
+ * After a congested epoch the allowed rate is halved, after a clear epoch
+ * it grows by CONFIG_APP_CONGESTION_INCREASE datagrams/s, always within
+ * [CONFIG_APP_CONGESTION_MIN_RATE, CONFIG_APP_CONGESTION_MAX_RATE]. The
+ * rate is applied as the minimum interval between two datagrams
+ * (interval()). BatchingSender holds partial batches back for that long, so
+ * under congestion the batches grow and fewer, larger datagrams are sent;
+ * no sample is dropped for pacing.
+ *
+ * The controller is updated by the transmit thread only; the shell reads
+ * its state without locking.
+ *
+ * Usage example:
+ * @code
+ * CongestionController congestion(client);
+ *
+ * while (true) {
+ *     congestion.update(k_uptime_get());
+ *     sender.setMinInterval(congestion.interval());
+ *     ...
+ * }
+ * @endcode
+ */
+class CongestionController {
+public:
+    /**
+     * @brief Controller state and counters since start-up (or the last reset)
+     */
+    struct Stats {
+        uint32_t epochs;            ///< Evaluated epochs
+        uint32_t congested_epochs;  ///< Epochs with at least one congestion signal
+        uint32_t would_block;       ///< Datagrams refused by UdpClient for lack of buffers
+        uint32_t errors;            ///< Datagrams UdpClient failed to send
+        uint32_t low_buffers;       ///< Epochs with less than a quarter of TX packets free
+        uint32_t stack_drops;       ///< IPv4/UDP drops in epochs with a send failure
+    };
+
+    /**
+     * @brief Constructor - watch a UDP client, start at the maximum rate
+     *
+     * The controller becomes the one shown by "sensor congestion".
+     *
+     * @param client UDP client whose Stats are evaluated (must outlive the controller)
+     */
+    explicit CongestionController(const UdpClient& client);
+
+    /**
+     * @brief Sample the congestion signals and adapt the rate at epoch ends
+     *
+     * Should be called on every iteration of the transmit loop; the TX
+     * buffer level is sampled on every call and the lowest level of an
+     * epoch is evaluated.
+     *
+     * @param now Current uptime in ms
+     */
+    void update(int64_t now);
+
+    /**
+     * @brief Get the allowed datagram rate in datagrams per second
+     */
+    inline uint32_t rate() const {
+        return rate_;
+    }
+
+    /**
+     * @brief Get the minimum interval between two datagrams in ms
+     */
+    inline uint32_t interval() const {
+        return 1000 / rate_;
+    }
+
+    /**
+     * @brief Check whether the last evaluated epoch was congested
+     *
+     * Optional traffic such as the store-and-forward backfill should wait
+     * while this is true.
+     */
+    inline bool congested() const {
+        return congested_;
+    }
+
+    /**
+     * @brief Get the lowest number of free TX packets seen in the last epoch
+     */
+    inline uint32_t txFreeLow() const {
+        return tx_free_last_;
+    }
+
+    /**
+     * @brief Get the counters
+     */
+    inline const Stats& stats() const {
+        return stats_;
+    }
+
+    /**
+     * @brief Clear the counters, the rate is kept
+     */
+    void resetStats();
+
+    /**
+     * @brief Get the controller shown by the shell, nullptr if none was created
+     */
+    static CongestionController* instance();
+
+private:
+    const UdpClient& client_;        ///< Source of send results
+    uint32_t rate_;                  ///< Allowed datagrams per second
+    bool congested_ = false;         ///< Last evaluated epoch was congested
+    int64_t epoch_end_ = 0;          ///< Uptime (ms) at which the current epoch ends
+    uint32_t last_would_block_ = 0;  ///< UdpClient::Stats::would_block at epoch start
+    uint32_t last_errors_ = 0;       ///< UdpClient::Stats::errors at epoch start
+    uint32_t last_drops_ = 0;        ///< Stack drop counter at epoch start
+    uint32_t tx_free_low_;           ///< Lowest free TX packet count in the current epoch
+    uint32_t tx_free_last_;          ///< Lowest free TX packet count in the last epoch
+    Stats stats_{};                  ///< Counters
+
+    /// Read the sum of the IPv4 and UDP drop counters, 0 without statistics
+    static uint32_t stackDrops();
+
+    /// Read the number of free TX packets
+    static uint32_t txFree();
+};
@@ -4,17 +4,22 @@
  * 
  * This file implements the UdpClient class using Zephyr's BSD socket API.
  * It provides UDP communication functionality for transmitting sensor data
- * to remote servers over Ethernet networks.
+ * to remote servers over Ethernet networks. The socket is connected once and
+ * datagrams are sent with MSG_DONTWAIT, so the caller never waits for the
+ * network stack.
  */
 
 #include "udp_client.h"
 
+#include <errno.h>
 #include <string.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>           // Zephyr Socket API
 #include <zephyr/posix/unistd.h>         // For close() function
 #include <zephyr/posix/arpa/inet.h>      // For inet_pton() function
 
+#include "latency_stats.h"
+
 LOG_MODULE_REGISTER(udp_client);
 
 /**
@@ -71,44 +76,95 @@ UdpClient::~UdpClient() {
 }
 
 /**
- * @brief Send data packet to configured target server
+ * @brief Move constructor - take over the socket of another client
+ */
+UdpClient::UdpClient(UdpClient&& other) noexcept
+    : sock_(other.sock_),
+      connected_(other.connected_),
+      server_addr_(other.server_addr_),
+      stats_(other.stats_) {
+    other.sock_ = -1;
+    other.connected_ = false;
+}
+
+/**
+ * @brief Move assignment - close the own socket and take over the other one
+ */
+UdpClient& UdpClient::operator=(UdpClient&& other) noexcept {
+    if (this != &other) {
+        if (sock_ >= 0) {
+            zsock_close(sock_);
+        }
+        sock_ = other.sock_;
+        connected_ = other.connected_;
+        server_addr_ = other.server_addr_;
+        stats_ = other.stats_;
+        other.sock_ = -1;
+        other.connected_ = false;
+    }
+    return *this;
+}
+
+/**
+ * @brief Connect the socket to the configured server
  * 
- * Transmits a data buffer to the target server using UDP protocol via Zephyr's
- * socket API. The function performs validation checks and handles partial sends.
+ * For UDP this only fixes the remote address (and selects the local
+ * address and route) in the network stack, so later sends skip the
+ * per-datagram destination lookup. Only the first failure is logged, the
+ * error counter covers repeats; the next send retries.
+ * 
+ * @return true if the socket is connected
+ */
+bool UdpClient::connect() {
+    if (zsock_connect(sock_, (struct sockaddr*)&server_addr_, sizeof(server_addr_)) < 0) {
+        if (stats_.errors == 0) {
+            LOG_ERR("Failed to connect UDP socket: errno %d", errno);
+        }
+        return false;
+    }
+    connected_ = true;
+    return true;
+}
+
+/**
+ * @brief Send data packet to configured target server without blocking
+ * 
+ * Transmits a data buffer on the connected socket with MSG_DONTWAIT. If the
+ * network stack cannot allocate a TX packet or buffer right away, the
+ * datagram is refused with kWouldBlock; this is the back-pressure signal for
+ * the caller. A partial send is treated as an error.
  * 
  * @param data Pointer to data buffer to transmit
  * @param len Size of data buffer in bytes
  * 
- * @return true if complete data packet was successfully transmitted
- * @return false if transmission failed or was incomplete
+ * @return SendResult Outcome of the transmission attempt
  * 
- * @note Function validates socket state before attempting transmission
- * @note Partial sends are treated as failures for data integrity
- * @note All error conditions are logged for debugging
+ * @note Nothing is logged per call; see stats() for the counters
  */
-bool UdpClient::send(const void* data, size_t len) {
-    // Validate socket is properly initialized
-    if (sock_ < 0) {
-        LOG_ERR("Cannot send data: UDP socket not initialized");
-        return false;
+SendResult UdpClient::send(const void* data, size_t len) {
+    if (sock_ < 0 || (!connected_ && !connect())) {
+        stats_.errors++;
+        return SendResult::kError;
     }
 
-    // Transmit data using Zephyr socket API
-    ssize_t bytes_sent = zsock_sendto(sock_, data, len, 0,
-                                     (struct sockaddr*)&server_addr_, sizeof(server_addr_));
-    
-    // Check for transmission errors
-    if (bytes_sent < 0) {
-        LOG_ERR("UDP transmission failed with error code: %d", bytes_sent);
-        return false;
+    ssize_t bytes_sent;
+    {
+        ScopedLatency measure(kStageSend);
+        bytes_sent = zsock_send(sock_, data, len, ZSOCK_MSG_DONTWAIT);
     }
-    
-    // Verify complete data transmission (no partial sends)
-    if (bytes_sent != static_cast<ssize_t>(len)) {
-        LOG_WRN("Incomplete UDP transmission: %d of %zu bytes sent", bytes_sent, len);
-        return false;
+
+    if (bytes_sent == static_cast<ssize_t>(len)) {
+        stats_.sent++;
+        return SendResult::kOk;
     }
-    
-    LOG_DBG("UDP packet transmitted successfully: %zu bytes", len);
-    return true;
+
+    // Out of TX packets or buffers: refused without waiting
+    if (bytes_sent < 0 &&
+        (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS || errno == ENOMEM)) {
+        stats_.would_block++;
+        return SendResult::kWouldBlock;
+    }
+
+    stats_.errors++;
+    return SendResult::kError;
 }
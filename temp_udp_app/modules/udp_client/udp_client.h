@@ -3,8 +3,8 @@
  * @brief UDP client implementation for network data transmission
  * 
  * This header provides a C++ UDP client class for transmitting sensor data
- * over Ethernet networks using Zephyr's networking stack. The client supports
- * connectionless UDP communication to a remote server.
+ * over Ethernet networks using Zephyr's networking stack. The socket is
+ * connected to the collector once and datagrams are sent without blocking.
  */
 
 #pragma once
@@ -14,6 +14,16 @@
 #include <zephyr/net/socket.h>
 
 #include <cstddef>  // for size_t
+#include <cstdint>
+
+/**
+ * @brief Outcome of UdpClient::send()
+ */
+enum class SendResult : uint8_t {
+    kOk,          ///< Datagram handed to the network stack
+    kWouldBlock,  ///< No TX buffers available right now, datagram not sent
+    kError,       ///< Socket or address error, datagram not sent
+};
 
 /**
  * @brief UDP client class for network data transmission
@@ -22,28 +32,45 @@
  * to a remote server. It manages socket creation, server address configuration,
  * and data transmission using Zephyr's BSD socket API.
  * 
- * The client is designed for sensor data transmission where reliability is
- * less critical than low latency and minimal overhead. UDP is connectionless,
- * so no connection establishment is required.
+ * The socket is connect()ed to the server on the first send, so the stack
+ * resolves the destination once instead of per datagram, and every datagram
+ * is sent with MSG_DONTWAIT. When the stack runs out of TX packets or
+ * buffers (CONFIG_NET_PKT_TX_COUNT, CONFIG_NET_BUF_TX_COUNT), send() returns
+ * SendResult::kWouldBlock immediately instead of stalling the caller, which
+ * can then drop or defer the data. Results are counted in Stats; send()
+ * itself does not log.
+ * 
+ * The client owns its socket and is therefore move-only.
  * 
  * Usage example:
  * @code
  * UdpClient client("192.168.1.100", 8888);
  * 
- * SensorData data = {25.5, 60.2, 12345};
- * if (client.send(&data, sizeof(data))) {
- *     printf("Data sent successfully\n");
+ * uint8_t datagram[64];
+ * size_t len = SensorProtocol::encode(header, samples, count, datagram, sizeof(datagram));
+ * if (client.send(datagram, len) == SendResult::kWouldBlock) {
+ *     // Network stack congested, try again later
  * }
  * @endcode
  */
 class UdpClient {
 public:
+    /**
+     * @brief Transmission counters since start-up
+     */
+    struct Stats {
+        uint32_t sent;         ///< Datagrams handed to the network stack
+        uint32_t would_block;  ///< Datagrams refused for lack of TX buffers
+        uint32_t errors;       ///< Datagrams failed for any other reason
+    };
+
     /**
      * @brief Constructor - Initialize UDP client with target server
      * 
      * Creates a UDP client configured to send data to the specified server.
      * The socket is created and the server address is configured during
-     * construction. No actual network connection is established (UDP is connectionless).
+     * construction. The socket is connected on the first send, so the client
+     * may be created before the network interface is up.
      * 
      * @param server_ip Target server IP address as string (e.g., "192.168.1.100")
      * @param server_port Target server port number (e.g., 8888)
@@ -61,26 +88,55 @@ public:
      */
     ~UdpClient();
 
+    UdpClient(const UdpClient&) = delete;
+    UdpClient& operator=(const UdpClient&) = delete;
+
     /**
-     * @brief Send data packet to configured server
+     * @brief Move constructor - take over the socket of another client
+     * 
+     * @param other Client left without a socket
+     */
+    UdpClient(UdpClient&& other) noexcept;
+
+    /**
+     * @brief Move assignment - close the own socket and take over the other one
+     * 
+     * @param other Client left without a socket
+     */
+    UdpClient& operator=(UdpClient&& other) noexcept;
+
+    /**
+     * @brief Send data packet to configured server without blocking
      * 
      * Transmits a data buffer to the target server using UDP protocol.
-     * The data is sent immediately without connection establishment or
-     * acknowledgment (UDP is connectionless and unreliable).
+     * The data is sent immediately without acknowledgment (UDP is
+     * unreliable). The call never waits for network buffers.
      * 
      * @param data Pointer to data buffer to transmit
      * @param len Size of data buffer in bytes
      * 
-     * @return true if data was successfully sent to network stack
-     * @return false if transmission failed (network error, invalid socket, etc.)
+     * @return SendResult::kOk if the datagram was handed to the network stack
+     * @return SendResult::kWouldBlock if the stack has no TX buffers available
+     * @return SendResult::kError on any other failure (invalid socket, no route, ...)
      * 
-     * @note Function may block briefly during network transmission
      * @note No delivery guarantee - UDP is unreliable protocol
      * @note Data should be properly formatted for receiver interpretation
      */
-    bool send(const void* data, size_t len);
+    SendResult send(const void* data, size_t len);
+
+    /**
+     * @brief Get the transmission counters
+     */
+    inline const Stats& stats() const {
+        return stats_;
+    }
 
 private:
-    int sock_;                      ///< UDP socket file descriptor
+    int sock_;                       ///< UDP socket file descriptor
+    bool connected_ = false;         ///< Socket is connected to server_addr_
     struct sockaddr_in server_addr_; ///< Target server address structure (IPv4)
+    Stats stats_{};                  ///< Transmission counters
+
+    /// Connect the socket to server_addr_, returns true on success
+    bool connect();
 };
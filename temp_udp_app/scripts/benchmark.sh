@@ -0,0 +1,16 @@
+#!/bin/bash
+# Build the native_sim pipeline benchmark and print its results.
+# Runs on any Linux machine with a Zephyr workspace; no board required.
+cd /workspace
+
+BUILD_DIR="zephyr-sht31-sensor/temp_udp_app/build_bench"
+
+west build -b native_sim zephyr-sht31-sensor/temp_udp_app -d "$BUILD_DIR" -- -DEXTRA_CONF_FILE=benchmark.conf
+
+if [ $? -ne 0 ]; then
+    echo "Build failed!"
+    exit 1
+fi
+
+# Only the benchmark report lines are of interest
+"$BUILD_DIR/zephyr/zephyr.exe" | grep "^BENCH"
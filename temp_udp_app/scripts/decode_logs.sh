@@ -0,0 +1,36 @@
+#!/bin/bash
+# Decode the binary dictionary log stream of a telemetry.conf build.
+#
+# Usage:
+#   decode_logs.sh <capture.bin>          decode a captured stream
+#   decode_logs.sh /dev/ttyACM0 [seconds] capture from the board (default 10 s), then decode
+#
+# BUILD_DIR selects the build whose log_dictionary.json matches the firmware.
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <capture.bin | serial device> [seconds]"
+    exit 1
+fi
+
+# Resolve the input before changing to the workspace, so relative paths work
+INPUT="$(realpath "$1")"
+cd /workspace
+
+BUILD_DIR="${BUILD_DIR:-zephyr-sht31-sensor/temp_udp_app/build_sht31}"
+DICTIONARY="$BUILD_DIR/zephyr/log_dictionary.json"
+PARSER="$ZEPHYR_BASE/scripts/logging/dictionary/log_parser.py"
+
+if [ ! -f "$DICTIONARY" ]; then
+    echo "Dictionary $DICTIONARY not found, build with -DEXTRA_CONF_FILE=telemetry.conf"
+    exit 1
+fi
+
+if [ -c "$INPUT" ]; then
+    # Raw 8-bit capture; the binary stream must not be altered by the tty layer
+    CAPTURE="$(mktemp --suffix=.bin)"
+    stty -F "$INPUT" 115200 raw -echo
+    timeout "${2:-10}" cat "$INPUT" > "$CAPTURE"
+    INPUT="$CAPTURE"
+fi
+
+python3 "$PARSER" "$DICTIONARY" "$INPUT"
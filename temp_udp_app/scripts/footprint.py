@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""Static RAM/ROM footprint of the firmware, per application module.
+
+Reads the symbol table of zephyr.elf with nm (sizes and the source file of
+every symbol from the debug info) and groups the symbols by where they are
+defined: the application modules (app/modules/<name>, app/src), the Zephyr
+tree (zephyr/<dir>/<subdir>) and the rest of the workspace (modules/hal, ...).
+Also lists the statically declared thread stacks and any heap arenas, so a
+regression in either shows up in one report.
+
+ROM counts code, read-only data and the initial values of initialized data;
+RAM counts initialized and zero-initialized data. Stack sizes are the
+declared sizes; the used part (high-water mark) is measured at run time with
+footprint.conf.
+
+Run through the build system, which passes the toolchain's nm:
+    west build -t app_footprint
+"""
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+# nm symbol types: text, read-only data, initialized data, zero-initialized
+# data; weak symbols (W/V) are counted as text/initialized data
+ROM_TYPES = set("tTrRwW")
+DATA_TYPES = set("dDvV")
+BSS_TYPES = set("bB")
+
+STACK_PATTERN = re.compile(r"stacks?$")
+HEAP_PATTERN = re.compile(r"heap")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="zephyr.elf of the build")
+    parser.add_argument("--nm", default="nm", help="nm of the target toolchain")
+    parser.add_argument("--app", required=True, help="application source directory")
+    parser.add_argument("--zephyr-base", required=True, help="Zephyr source directory")
+    parser.add_argument("--top", type=int, default=12, help="largest symbols to list per module")
+    return parser.parse_args()
+
+
+def read_symbols(nm, elf):
+    """Yield (name, type, size, source file or None) for every sized symbol."""
+    command = [nm, "--print-size", "--size-sort", "--radix=d", "--line-numbers", "--demangle", elf]
+    output = subprocess.run(command, check=True, capture_output=True, text=True).stdout
+    for line in output.splitlines():
+        symbol, _, location = line.partition("\t")
+        fields = symbol.split(maxsplit=3)
+        if len(fields) != 4:
+            continue
+        _, size, kind, name = fields
+        source = location.rsplit(":", 1)[0] if location else None
+        yield name, kind, int(size), source
+
+
+def module_of(source, app, zephyr_base):
+    """Map a source file to the module it belongs to."""
+    if source is None:
+        return "(no debug info)"
+    source = os.path.normpath(source)
+    workspace = os.path.dirname(zephyr_base)
+    for root, prefix in ((app, ["app"]), (zephyr_base, ["zephyr"]), (workspace, [])):
+        if os.path.commonpath([root, source]) == root:
+            # Two directory levels below the root, e.g. app/modules/pipeline
+            parts = prefix + os.path.relpath(source, root).split(os.sep)[:-1][:2]
+            return "/".join(parts) if parts else "(workspace)"
+    return "(other)"
+
+
+def main():
+    args = parse_args()
+    app = os.path.realpath(args.app)
+    zephyr_base = os.path.realpath(args.zephyr_base)
+
+    rom = collections.Counter()
+    ram = collections.Counter()
+    largest = collections.defaultdict(list)
+    stacks = []
+    heaps = []
+
+    for name, kind, size, source in read_symbols(args.nm, args.elf):
+        module = module_of(source, app, zephyr_base)
+        if kind in ROM_TYPES:
+            rom[module] += size
+        elif kind in DATA_TYPES:
+            rom[module] += size
+            ram[module] += size
+        elif kind in BSS_TYPES:
+            ram[module] += size
+        else:
+            continue
+        largest[module].append((size, name))
+
+        if kind in DATA_TYPES | BSS_TYPES:
+            if STACK_PATTERN.search(name):
+                stacks.append((size, name, module))
+            elif HEAP_PATTERN.search(name):
+                heaps.append((size, name, module))
+
+    modules = sorted(set(rom) | set(ram), key=lambda m: (not m.startswith("app"), m))
+    print(f"{'module':<36} {'ROM':>9} {'RAM':>9}")
+    for module in modules:
+        print(f"{module:<36} {rom[module]:>9} {ram[module]:>9}")
+    print(f"{'total':<36} {sum(rom.values()):>9} {sum(ram.values()):>9}")
+
+    print("\nLargest application symbols:")
+    for module in (m for m in modules if m.startswith("app")):
+        for size, name in sorted(largest[module], reverse=True)[:args.top]:
+            print(f"  {module:<28} {size:>7}  {name}")
+
+    print("\nThread stacks (declared size; run with footprint.conf for the used part):")
+    for size, name, module in sorted(stacks, reverse=True):
+        print(f"  {name:<40} {size:>7}  {module}")
+    print(f"  {'total':<40} {sum(s for s, _, _ in stacks):>7}")
+
+    print("\nHeap arenas:")
+    if not heaps:
+        print("  none")
+    for size, name, module in sorted(heaps, reverse=True):
+        print(f"  {name:<40} {size:>7}  {module}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,16 @@
+#!/bin/bash
+# Build the board firmware with the stack analysis fragment and print the
+# static RAM/ROM per module. Flash the result to read the thread stack
+# high-water marks from the console (thread analyzer, every 10 s).
+cd /workspace
+
+BUILD_DIR="zephyr-sht31-sensor/temp_udp_app/build_footprint"
+
+west build -b nucleo_h755zi_q/stm32h755xx/m7 zephyr-sht31-sensor/temp_udp_app -d "$BUILD_DIR" -- -DDTC_OVERLAY_FILE="boards/nucleo_h755zi_q.overlay" -DEXTRA_CONF_FILE=footprint.conf
+
+if [ $? -ne 0 ]; then
+    echo "Build failed!"
+    exit 1
+fi
+
+west build -d "$BUILD_DIR" -t app_footprint
@@ -0,0 +1,232 @@
+/**
+ * @file benchmark.cpp
+ * @brief End-to-end pipeline benchmark for native_sim builds
+ *
+ * The benchmark runs the regular sensor -> batching -> UDP path against the
+ * emulated SHT3x and an in-process UDP sink bound to the loopback interface.
+ * Every phase uses a shorter sampling interval; for each phase it reports
+ * the achieved sample rate, losses, the end-to-end latency distribution
+ * (sensor reading to datagram reception) and the host CPU time per sample.
+ */
+
+#include "benchmark.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/printk.h>
+
+#include <posix_board_if.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "batching_sender.h"
+#include "benchmark_host.h"
+#include "device_clock.h"
+#include "latency_histogram.h"
+#include "multi_sensor_handler.h"
+#include "sensor_protocol.h"
+#include "udp_client.h"
+
+/// Target sampling intervals of the phases in ms, 0 runs without pause
+static constexpr uint32_t kPhaseIntervalsMs[] = {100, 20, 10, 5, 2, 1, 0};
+
+/// Minimum fraction (percent) of the target rate a phase has to reach
+static constexpr uint32_t kSustainedPercent = 95;
+
+/// Longest time to wait for the sink to receive the last datagram of a phase
+static constexpr int64_t kDrainTimeoutMs = 1000;
+
+K_THREAD_STACK_DEFINE(sink_stack, 4096);
+static struct k_thread sink_thread;
+static K_SEM_DEFINE(sink_ready, 0, 1);
+
+/**
+ * @brief Counters of the in-process UDP sink
+ */
+struct SinkStats {
+    std::atomic<uint32_t> datagrams{0};  ///< Well-formed datagrams received
+    std::atomic<uint32_t> samples{0};    ///< Samples received
+    std::atomic<uint32_t> malformed{0};  ///< Datagrams that failed to decode
+    LatencyHistogram latency_ms;         ///< Reception time minus sample timestamp
+};
+
+static SinkStats sink_stats;
+
+/**
+ * @brief Sink thread entry point
+ *
+ * Receives datagrams on the benchmark port, decodes them and records the
+ * end-to-end latency of every sample.
+ */
+static void sink_thread_entry(void*, void*, void*) {
+    int sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(CONFIG_APP_UDP_TARGET_PORT);
+    zsock_inet_pton(AF_INET, CONFIG_APP_UDP_TARGET_ADDR, &addr.sin_addr);
+
+    if (sock < 0 || zsock_bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        printk("BENCH error: cannot bind sink to %s:%d (errno %d)\n", CONFIG_APP_UDP_TARGET_ADDR,
+               CONFIG_APP_UDP_TARGET_PORT, errno);
+        posix_exit(1);
+    }
+    k_sem_give(&sink_ready);
+
+    static uint8_t buf[SensorProtocol::encodedSize(SensorProtocol::kMaxSamples)];
+    static WireSample samples[SensorProtocol::kMaxSamples];
+
+    while (true) {
+        const ssize_t len = zsock_recv(sock, buf, sizeof(buf), 0);
+        if (len <= 0) {
+            continue;
+        }
+
+        const uint64_t now = DeviceClock::nowUs();
+        WirePacketHeader header;
+        if (!SensorProtocol::decode(buf, static_cast<size_t>(len), header, samples,
+                                    SensorProtocol::kMaxSamples)) {
+            sink_stats.malformed++;
+            continue;
+        }
+
+        for (size_t i = 0; i < header.count; ++i) {
+            const uint64_t ts = samples[i].timestamp_us;
+            sink_stats.latency_ms.record(now > ts ? static_cast<uint32_t>((now - ts) / 1000) : 0);
+        }
+        sink_stats.samples += header.count;
+        sink_stats.datagrams++;
+    }
+}
+
+/**
+ * @brief Result of one benchmark phase
+ */
+struct PhaseResult {
+    uint32_t produced;   ///< Samples handed to the BatchingSender
+    uint32_t received;   ///< Samples decoded by the sink
+    uint32_t rate_mhz;   ///< Achieved rate in simulated time (milli-Hz)
+    uint64_t cpu_ns;     ///< Host CPU time of the phase
+    uint64_t wall_ns;    ///< Host wall time of the phase
+};
+
+/**
+ * @brief Run the pipeline at one sampling interval
+ *
+ * @param sensors     Sensor handler (emulated sensors)
+ * @param sender      Batching layer in front of the UDP client
+ * @param interval_ms Pause between two sensor cycles, 0 for none
+ *
+ * @return PhaseResult Counters of the phase
+ */
+static PhaseResult runPhase(MultiSensorHandler& sensors, BatchingSender& sender,
+                            uint32_t interval_ms) {
+    PhaseResult result{};
+    const uint32_t received_before = sink_stats.samples.load();
+    sink_stats.latency_ms.reset();
+
+    const uint64_t cpu_start = benchmark_host_cpu_ns();
+    const uint64_t wall_start = benchmark_host_wall_ns();
+    const int64_t start = k_uptime_get();
+    const int64_t end = start + CONFIG_APP_BENCHMARK_PHASE_MS;
+
+    while (k_uptime_get() < end) {
+        sensors.update();
+        for (size_t i = 0; i < MultiSensorHandler::kSensorCount; ++i) {
+            if (sensors.isValid(i)) {
+                sender.add(sensors.getData(i));
+                result.produced++;
+            }
+        }
+        sender.poll();
+
+        if (interval_ms > 0) {
+            k_sleep(K_MSEC(interval_ms));
+        }
+    }
+    sender.flush();
+    const int64_t elapsed_ms = k_uptime_get() - start;
+
+    // Give the sink time to receive the tail of the phase
+    const int64_t drain_end = k_uptime_get() + kDrainTimeoutMs;
+    while (sink_stats.samples.load() - received_before < result.produced &&
+           k_uptime_get() < drain_end) {
+        k_sleep(K_MSEC(10));
+    }
+
+    result.received = sink_stats.samples.load() - received_before;
+    result.rate_mhz = static_cast<uint32_t>(static_cast<uint64_t>(result.produced) * 1000000 /
+                                            (elapsed_ms > 0 ? elapsed_ms : 1));
+    result.cpu_ns = benchmark_host_cpu_ns() - cpu_start;
+    result.wall_ns = benchmark_host_wall_ns() - wall_start;
+    return result;
+}
+
+/**
+ * @brief Run the benchmark phases and terminate the process
+ *
+ * A phase is sustainable when the sink received every sample and the
+ * achieved rate is at least kSustainedPercent of the target rate. The
+ * highest sustainable rate is reported as the result.
+ */
+int runBenchmark() {
+    DeviceClock::init();
+
+    static MultiSensorHandler sensors;
+    UdpClient client(CONFIG_APP_UDP_TARGET_ADDR, CONFIG_APP_UDP_TARGET_PORT);
+    BatchingSender sender(client);
+
+    k_thread_create(&sink_thread, sink_stack, K_THREAD_STACK_SIZEOF(sink_stack),
+                    sink_thread_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+    k_thread_name_set(&sink_thread, "bench_sink");
+    k_sem_take(&sink_ready, K_FOREVER);
+
+    printk("BENCH start sensors=%u batch=%u phase_ms=%d\n",
+           static_cast<unsigned>(MultiSensorHandler::kSensorCount),
+           static_cast<unsigned>(BatchingSender::kMaxSamples), CONFIG_APP_BENCHMARK_PHASE_MS);
+
+    uint32_t best_mhz = 0;
+
+    for (uint32_t interval_ms : kPhaseIntervalsMs) {
+        const PhaseResult r = runPhase(sensors, sender, interval_ms);
+
+        // Target rate over all sensors; unbounded without a pause
+        const uint32_t target_mhz =
+            interval_ms > 0 ? static_cast<uint32_t>(1000000 * MultiSensorHandler::kSensorCount /
+                                                    interval_ms)
+                            : 0;
+        const bool lossless = r.received == r.produced;
+        const bool on_target =
+            static_cast<uint64_t>(r.rate_mhz) * 100 >= static_cast<uint64_t>(target_mhz) *
+                                                           kSustainedPercent;
+        const uint64_t cpu_ns_per_sample = r.produced > 0 ? r.cpu_ns / r.produced : 0;
+
+        printk("BENCH phase interval_ms=%u target_hz=%u.%03u rate_hz=%u.%03u produced=%u "
+               "received=%u lost=%u lat_p50_ms=%u lat_p99_ms=%u lat_max_ms=%u "
+               "cpu_ns_per_sample=%llu cpu_limit_hz=%llu wall_ms=%llu %s\n",
+               interval_ms, target_mhz / 1000, target_mhz % 1000, r.rate_mhz / 1000,
+               r.rate_mhz % 1000, r.produced, r.received, r.produced - r.received,
+               sink_stats.latency_ms.percentile(50), sink_stats.latency_ms.percentile(99),
+               sink_stats.latency_ms.max(), static_cast<unsigned long long>(cpu_ns_per_sample),
+               static_cast<unsigned long long>(cpu_ns_per_sample > 0
+                                                   ? 1000000000ull / cpu_ns_per_sample
+                                                   : 0),
+               static_cast<unsigned long long>(r.wall_ns / 1000000),
+               lossless && on_target ? "sustained" : "saturated");
+
+        if (lossless && on_target && r.rate_mhz > best_mhz) {
+            best_mhz = r.rate_mhz;
+        }
+    }
+
+    const BatchingSender::Stats& stats = sender.stats();
+    printk("BENCH result max_sustainable_hz=%u.%03u datagrams=%u malformed=%u "
+           "wire_bytes=%llu plain_bytes=%llu\n",
+           best_mhz / 1000, best_mhz % 1000, stats.datagrams, sink_stats.malformed.load(),
+           static_cast<unsigned long long>(stats.wire_bytes),
+           static_cast<unsigned long long>(stats.plain_bytes));
+
+    posix_exit(0);
+    return 0;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file benchmark.h
+ * @brief End-to-end pipeline benchmark for native_sim builds
+ */
+
+#pragma once
+
+/**
+ * @brief Run the benchmark phases and terminate the process
+ *
+ * Drives MultiSensorHandler -> BatchingSender -> UdpClient against an
+ * in-process UDP sink on the loopback interface, once per target sampling
+ * interval, and prints one "BENCH" line per phase plus a summary.
+ *
+ * @return int Exit code (only returned if the process could not be terminated)
+ */
+int runBenchmark();
@@ -0,0 +1,27 @@
+/**
+ * @file benchmark_host.c
+ * @brief Host side of the benchmark clocks (built into the native_sim runner)
+ *
+ * This file is compiled against the host C library, not against Zephyr.
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+static uint64_t benchmark_clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t benchmark_host_cpu_ns(void)
+{
+    return benchmark_clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+uint64_t benchmark_host_wall_ns(void)
+{
+    return benchmark_clock_ns(CLOCK_MONOTONIC);
+}
@@ -0,0 +1,26 @@
+/**
+ * @file benchmark_host.h
+ * @brief Host clocks for the native_sim benchmark
+ *
+ * On native_sim the Zephyr kernel clock is simulated: code runs in zero
+ * simulated time. These functions are implemented on the host side of the
+ * native simulator runner and read the clocks of the Linux process.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// CPU time consumed by the whole process in nanoseconds (CLOCK_PROCESS_CPUTIME_ID)
+uint64_t benchmark_host_cpu_ns(void);
+
+/// Host monotonic wall clock in nanoseconds (CLOCK_MONOTONIC)
+uint64_t benchmark_host_wall_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,36 +3,236 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
-#include "sensor_handler.h"
+#include "batching_sender.h"
+#include "benchmark.h"
+#if defined(CONFIG_APP_CONGESTION_CONTROL)
+#include "congestion_controller.h"
+#endif
+#if defined(CONFIG_APP_STORE_FORWARD)
+#include "datagram_store.h"
+#endif
+#include "device_clock.h"
+#include "latency_stats.h"
+#include "multi_sensor_handler.h"
+#include "periodic_scheduler.h"
+#include "sample_log.h"
+#include "sensor_pipeline.h"
 #include "udp_client.h"
 
 LOG_MODULE_REGISTER(main);
 
+#if defined(CONFIG_APP_AGGREGATION)
+/// Per-sensor window statistics between the sample ring and the UDP client
+using TransmitStage =
+    AggregateStage<MultiSensorHandler::kSensorCount, CONFIG_APP_AGGREGATION_PANES>;
+#elif defined(CONFIG_APP_DEADBAND)
+/// Report-on-change: only samples outside the deadband (or heartbeats) are sent
+using TransmitStage = FilterStage<DeadbandPolicy>;
+#else
+using TransmitStage = FilterStage<SendAlwaysPolicy>;
+#endif
+
+/// Sample ring, wake-up semaphore and transmit stage, sized at compile time
+using Pipeline = SensorPipeline<MultiSensorHandler::kSensorCount, CONFIG_APP_SAMPLE_RING_CAPACITY,
+                                TransmitStage>;
+
+#if defined(CONFIG_APP_AGGREGATION)
+static Pipeline pipeline(CONFIG_APP_AGGREGATION_WINDOW_MS);
+#elif defined(CONFIG_APP_DEADBAND)
+static Pipeline pipeline(CONFIG_APP_DEADBAND_TEMPERATURE, CONFIG_APP_DEADBAND_HUMIDITY,
+                         CONFIG_APP_DEADBAND_HEARTBEAT_MS);
+#else
+static Pipeline pipeline;
+#endif
+
+#if defined(CONFIG_APP_STORE_FORWARD)
+/// Datagrams that could not be sent, replayed once the collector is reachable
+static DatagramStore datagram_store;
+#endif
+
+/// Rate-limited summary of the samples, replaces one log line per sample
+static SampleLog sample_log(CONFIG_APP_LOG_SUMMARY_INTERVAL_MS);
+
+/// Periodic tasks of the sampling thread, on absolute deadlines
+static PeriodicScheduler scheduler;
+
+K_THREAD_STACK_DEFINE(sampling_stack, CONFIG_APP_SAMPLING_THREAD_STACK_SIZE);
+static struct k_thread sampling_thread;
+
+/**
+ * @brief Sample task - read all sensors once and queue the results
+ *
+ * Pushes the tagged results into the pipeline's sample ring. The task never touches the
+ * network, so a slow send cannot delay the next measurement. If the transmit
+ * thread falls behind, samples are dropped (and counted) by the ring instead
+ * of blocking this thread. Nothing is logged per sample; the transmit thread
+ * logs a summary every CONFIG_APP_LOG_SUMMARY_INTERVAL_MS.
+ *
+ * @param user Pointer to the MultiSensorHandler instance
+ */
+static void sample_task(void* user) {
+    MultiSensorHandler& sensors = *static_cast<MultiSensorHandler*>(user);
+    static LoopPeriodTracker loop_period;
+
+    // Period and jitter of the sampling loop ("sensor stats")
+    loop_period.tick();
+
+    // Sample all sensors; measurements of several sensors overlap
+    sensors.update();
+
+    for (size_t i = 0; i < MultiSensorHandler::kSensorCount; ++i) {
+        if (!sensors.isValid(i)) {
+            // Log sensor read failure
+            LOG_ERR("Sensor %u reading failed", static_cast<unsigned>(i));
+            continue;
+        }
+
+        // Get reference to SensorData structure (contains temp, humidity, timestamp, sensor)
+        const SensorData& sensor_data = sensors.getData(i);
+
+        // Hand the sample over to the transmit thread
+        pipeline.push(sensor_data);
+    }
+}
+
+/**
+ * @brief Health task - report ring overflows and missed deadlines
+ *
+ * Runs at CONFIG_APP_HEALTH_INTERVAL_MS, so an overloaded system produces
+ * one warning per interval instead of one per sample.
+ */
+static void health_task(void*) {
+    static uint32_t reported_drops;
+    static uint32_t reported_misses;
+
+    // Ring overflows indicate the transmit path is too slow
+    const uint32_t drops = pipeline.ring().drops();
+    if (drops != reported_drops) {
+        LOG_WRN("Sample ring overflow: %u samples dropped in total (high water %u/%u)", drops,
+                pipeline.ring().highWater(), static_cast<unsigned>(Pipeline::Ring::capacity()));
+        reported_drops = drops;
+    }
+
+    // Missed deadlines indicate a sample period shorter than one sensor cycle
+    uint32_t misses = 0;
+    for (size_t i = 0; i < scheduler.taskCount(); ++i) {
+        misses += scheduler.stats(i).misses;
+    }
+    if (misses != reported_misses) {
+        LOG_WRN("Scheduler: %u deadlines missed in total (see \"sensor sched\")", misses);
+        reported_misses = misses;
+    }
+}
+
+/**
+ * @brief Sampling thread entry point
+ *
+ * Runs the sample task every CONFIG_APP_SAMPLE_INTERVAL_MS on absolute
+ * deadlines, so the sampling rate stays exact regardless of how long a
+ * sensor cycle takes, plus the health task at its own rate. In periodic
+ * mode the sensors pace the thread instead (a new sample whenever their
+ * conversion is complete) and the health task piggybacks on that loop.
+ *
+ * @param p1 Pointer to the MultiSensorHandler instance
+ */
+static void sampling_thread_entry(void* p1, void*, void*) {
+#if defined(CONFIG_SHT3XD_PERIODIC_MODE)
+    scheduler.add("health", CONFIG_APP_HEALTH_INTERVAL_MS, health_task, nullptr);
+
+    while (true) {
+        sample_task(p1);
+        scheduler.runDue();
+    }
+#else
+    scheduler.add("sample", CONFIG_APP_SAMPLE_INTERVAL_MS, sample_task, p1);
+    scheduler.add("health", CONFIG_APP_HEALTH_INTERVAL_MS, health_task, nullptr);
+    scheduler.run();
+#endif
+}
+
+/**
+ * @brief Block the transmit thread until a sample arrives or a deadline is reached
+ *
+ * With store-and-forward the thread also wakes up for the next backfill
+ * burst while stored datagrams are pending.
+ *
+ * @param wake Uptime (ms) of the next deadline, INT64_MAX for none
+ */
+static void wait_for_samples(int64_t wake) {
+#if defined(CONFIG_APP_STORE_FORWARD)
+    if (datagram_store.pending() && datagram_store.nextBurst() < wake) {
+        wake = datagram_store.nextBurst();
+    }
+#endif
+    pipeline.wait(wake);
+}
+
 /**
  * @brief Main application entry point
  *
- * This function initializes the SensorHandler and UDP client, then continuously
- * processes sensor data and transmits it via UDP at 1Hz to the configured remote
- * server. The application uses a clean architecture with SensorHandler managing
- * all sensor operations and data caching.
+ * This function initializes the MultiSensorHandler and UDP client, starts the
+ * sampling thread and then acts as the transmit thread. Samples are taken
+ * from the lock-free sample ring of the SensorPipeline and handed through
+ * its transmit stage to the BatchingSender, which transmits up to
+ * CONFIG_APP_UDP_BATCH_SIZE samples per datagram. The pipeline, the UDP
+ * client and the sender are statically allocated; the application uses no
+ * heap (CONFIG_HEAP_MEM_POOL_SIZE=0).
+ *
+ * With CONFIG_APP_AGGREGATION the samples are folded into per-sensor
+ * window statistics instead and only one summary per sensor and window is
+ * transmitted. Otherwise every sample passes the TransmitPolicy first, which
+ * with CONFIG_APP_DEADBAND suppresses samples that did not change. With
+ * CONFIG_APP_STORE_FORWARD datagrams that cannot be sent are kept in flash
+ * and replayed after the live traffic once the collector is reachable.
+ * With CONFIG_APP_CONGESTION_CONTROL the datagram rate follows the network
+ * stack back-pressure (AIMD) and the backfill pauses while it is congested.
  *
  * Architecture flow:
- * SensorHandler.update() -> SensorData (with timestamp) -> UDP transmission
+ * Sampling thread: MultiSensorHandler.update() -> SensorData (tagged, numbered, us) -> SpscRing
+ * Main thread:     SpscRing -> FilterStage (TransmitPolicy) -> BatchingSender -> UDP transmission
+ *                  SpscRing -> AggregateStage (WindowAggregator) -> BatchingSender -> UDP
+ *                  BatchingSender -> DatagramStore -> UDP backfill (store-and-forward)
  *
  * @return int Return code (never reached due to infinite loop)
  */
 int main(void) {
-    // Initialize high-level sensor handler for SHT31 temperature/humidity sensor
-    // SensorHandler encapsulates SHT3xReader and manages SensorData internally
-    SensorHandler my_sensor;
+#if defined(CONFIG_APP_BENCHMARK)
+    // native_sim benchmark build: measure the pipeline instead of running it
+    return runBenchmark();
+#endif
+
+    // Pick the boot ID; with CONFIG_APP_TIME_SYNC also start the SNTP alignment
+    DeviceClock::init();
+
+    // Initialize high-level sensor handler for all SHT31 temperature/humidity sensors
+    // MultiSensorHandler owns one SHT3xReader per devicetree node
+    static MultiSensorHandler my_sensors;
 
     // Initialize UDP client with target server IP and port
-    // Target: 192.168.1.37:8888
-    UdpClient udp_client("192.168.1.37", 8888);
+    // Default target: 192.168.1.37:8888 (127.0.0.1 on native_sim)
+    static UdpClient udp_client(CONFIG_APP_UDP_TARGET_ADDR, CONFIG_APP_UDP_TARGET_PORT);
+
+    // Keep datagrams in flash while the collector is unreachable
+    DatagramStore* store = nullptr;
+#if defined(CONFIG_APP_STORE_FORWARD)
+    if (datagram_store.init()) {
+        store = &datagram_store;
+    }
+#endif
+
+    // Collect samples and transmit them as multi-sample datagrams
+    static BatchingSender batch_sender(udp_client, store);
+
+#if defined(CONFIG_APP_CONGESTION_CONTROL)
+    // Pace the datagrams according to the TX back-pressure ("sensor congestion")
+    static CongestionController congestion(udp_client);
+#endif
 
     LOG_INF("=== SHT31 Sensor UDP Transmitter ===");
-    LOG_INF("Using SensorHandler with integrated SensorData management");
-    LOG_INF("Target server: 192.168.1.37:8888");
+    LOG_INF("Using MultiSensorHandler with %u sensor(s)",
+            static_cast<unsigned>(MultiSensorHandler::kSensorCount));
+    LOG_INF("Target server: %s:%d", CONFIG_APP_UDP_TARGET_ADDR, CONFIG_APP_UDP_TARGET_PORT);
+    LOG_INF("Sampling interval: %d ms", CONFIG_APP_SAMPLE_INTERVAL_MS);
 
     // Wait for network initialization to complete
     // This ensures Ethernet interface is up and IP is configured
@@ -40,40 +240,70 @@ int main(void) {
     k_sleep(K_SECONDS(3));
     LOG_INF("Starting sensor data transmission loop");
 
-    // Main application loop - runs continuously
+    // Start sampling in its own thread, independent of network latency
+    k_thread_create(&sampling_thread, sampling_stack, K_THREAD_STACK_SIZEOF(sampling_stack),
+                    sampling_thread_entry, &my_sensors, NULL, NULL,
+                    CONFIG_APP_SAMPLING_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&sampling_thread, "sampling");
+
+#if defined(CONFIG_APP_AGGREGATION)
+    LOG_INF("Aggregating over %u ms windows, %d pane(s)",
+            pipeline.stage().aggregator().windowMs(), CONFIG_APP_AGGREGATION_PANES);
+#elif defined(CONFIG_APP_DEADBAND)
+    uint32_t considered = 0;
+#endif
+
+    // Called for every sample before it reaches the transmit stage
+    auto observe = [&](const SensorData& sample) {
+        sample_log.record(sample);
+
+#if defined(CONFIG_APP_DEADBAND)
+        // Periodic summary of the report-on-change savings
+        if (++considered % CONFIG_APP_DEADBAND_REPORT_INTERVAL == 0) {
+            const DeadbandPolicy& policy = pipeline.stage().policy();
+            LOG_INF("Deadband: %u samples sent, %u suppressed", policy.admitted(),
+                    policy.suppressed());
+        }
+#endif
+    };
+
+    // Transmit loop - runs continuously
     while (true) {
-        // Update sensor readings using SensorHandler
-        // This calls SHT3xReader internally and updates SensorData with timestamp
-        if (my_sensor.update()) {
-            // Get reference to SensorData structure (contains temp, humidity, timestamp)
-            const SensorData& sensor_data = my_sensor.getData();
-            
-            // Log sensor readings locally via UART
-            // Explicit cast to double to avoid float-to-double promotion warnings
-            LOG_INF("Sensor readings: %.2f deg, %.2f %%", 
-                    (double)sensor_data.temperature, (double)sensor_data.humidity);
-
-            // Transmit complete SensorData structure via UDP
-            // SensorData is packed and optimized for network transmission
-            if (udp_client.send(&sensor_data, sizeof(sensor_data))) {
-                // Log successful transmission with timestamp
-                // Explicit casts to avoid float-to-double promotion warnings
-                LOG_INF("UDP transmitted: %.2f deg, %.2f %% [%u ms]", 
-                        (double)sensor_data.temperature,
-                        (double)sensor_data.humidity, 
-                        sensor_data.timestamp);
-            } else {
-                // Log transmission failure
-                LOG_ERR("UDP transmission failed");
-            }
-        } else {
-            // Log sensor read failure
-            LOG_ERR("Sensor reading failed");
+        // Sleep until a new sample arrives or the stage has time-based work:
+        // a partial batch whose latency budget ends, or the end of a window pane
+        wait_for_samples(pipeline.deadline(batch_sender));
+
+        // Drain everything the sampling thread produced since the last wake-up.
+        // A batch refused for lack of TX buffers is dropped and counted, not logged
+        if (pipeline.drain(batch_sender, observe) == SendResult::kError) {
+            LOG_ERR("UDP transmission failed");
+        }
+
+        // Transmit a partial batch or close windows on time even if no sample arrived
+        if (pipeline.poll(k_uptime_get(), batch_sender) == SendResult::kError) {
+            LOG_ERR("UDP transmission failed");
+        }
+
+#if defined(CONFIG_APP_CONGESTION_CONTROL)
+        // Fewer, larger datagrams while the network stack is short of buffers
+        congestion.update(k_uptime_get());
+        batch_sender.setMinInterval(congestion.interval());
+#endif
+
+#if defined(CONFIG_APP_STORE_FORWARD)
+        // Replay stored datagrams after the live traffic, at a bounded rate and
+        // only while the network stack is not congested
+        bool backfill = true;
+#if defined(CONFIG_APP_CONGESTION_CONTROL)
+        backfill = !congestion.congested();
+#endif
+        if (backfill) {
+            datagram_store.backfill(udp_client, k_uptime_get());
         }
+#endif
 
-        // Wait 1 second before next sensor reading
-        // This creates a 1Hz sampling rate
-        k_sleep(K_SECONDS(1));
+        // Latest values per sensor, at most once per summary interval
+        sample_log.poll(k_uptime_get());
     }
 
     // This return is never reached due to infinite loop
@@ -0,0 +1,55 @@
+/**
+ * @file fake_udp_client.cpp
+ * @brief UdpClient without a socket, driven by the FakeNetwork budget
+ */
+
+#include "fake_udp_client.h"
+
+#include <cstring>
+
+#include "sensor_protocol.h"
+#include "udp_client.h"
+
+FakeNetwork fake_network;
+
+void fakeNetworkReset(size_t budget) {
+    memset(&fake_network, 0, sizeof(fake_network));
+    fake_network.budget = budget;
+}
+
+UdpClient::UdpClient(const char* server_ip, uint16_t server_port) : sock_(-1) {
+    ARG_UNUSED(server_ip);
+    ARG_UNUSED(server_port);
+}
+
+UdpClient::~UdpClient() {
+}
+
+/**
+ * @brief Accept the datagram while the budget lasts
+ *
+ * @return SendResult::kOk, or SendResult::kWouldBlock once the budget is used up
+ */
+SendResult UdpClient::send(const void* data, size_t len) {
+    if (fake_network.budget == 0) {
+        fake_network.refused++;
+        stats_.would_block++;
+        return SendResult::kWouldBlock;
+    }
+    if (fake_network.budget != SIZE_MAX) {
+        fake_network.budget--;
+    }
+
+    WirePacketHeader header{};
+    const bool valid = SensorProtocol::decodeHeader(static_cast<const uint8_t*>(data), len,
+                                                    header);
+    if (!valid || (header.flags & kFlagBackfill) == 0) {
+        fake_network.unflagged++;
+    }
+    if (fake_network.sent < FakeNetwork::kMaxSent) {
+        fake_network.sequences[fake_network.sent] = valid ? header.sequence : UINT32_MAX;
+    }
+    fake_network.sent++;
+    stats_.sent++;
+    return SendResult::kOk;
+}
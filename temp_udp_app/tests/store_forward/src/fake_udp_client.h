@@ -0,0 +1,38 @@
+/**
+ * @file fake_udp_client.h
+ * @brief Scripted network behind UdpClient for the store-and-forward tests
+ *
+ * fake_udp_client.cpp replaces udp_client.cpp: UdpClient::send() accepts
+ * a set number of datagrams and then refuses with SendResult::kWouldBlock,
+ * like a network stack without TX buffers. Accepted datagrams are recorded
+ * by header sequence number.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief State of the fake network, shared by all UdpClient objects
+ */
+struct FakeNetwork {
+    /// Accepted datagrams that are recorded
+    static constexpr size_t kMaxSent = 4096;
+
+    size_t budget;                  ///< Datagrams still accepted, SIZE_MAX = all
+    size_t sent;                    ///< Datagrams accepted
+    size_t refused;                 ///< Datagrams refused
+    size_t unflagged;               ///< Accepted datagrams without kFlagBackfill
+    uint32_t sequences[kMaxSent];   ///< Header sequence number of each accepted datagram
+};
+
+/// The fake network
+extern FakeNetwork fake_network;
+
+/**
+ * @brief Clear the recorded datagrams and set the send budget
+ *
+ * @param budget Number of datagrams accepted before sends are refused
+ */
+void fakeNetworkReset(size_t budget);
@@ -0,0 +1,206 @@
+/**
+ * @file main.cpp
+ * @brief DatagramStore tests on the simulated flash of native_sim
+ *
+ * Every test starts with an erased storage_partition. Datagrams are offered
+ * to the fake UdpClient first and stored when it refuses them, as the
+ * transmit thread does; backfill() is then driven with explicit uptimes,
+ * so the burst limit is checked without sleeping.
+ */
+
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/ztest.h>
+
+#include "datagram_store.h"
+#include "fake_udp_client.h"
+#include "sensor_protocol.h"
+
+/// Size of the test datagrams (one sample each)
+static constexpr size_t kDatagramSize = SensorProtocol::encodedSize(1);
+
+/// Test datagrams per RAM page / flash page
+static constexpr size_t kPerPage =
+    DatagramStore::kPageSize / (DatagramStore::kRecordHeaderSize + kDatagramSize);
+
+static constexpr size_t kBurst = CONFIG_APP_STORE_FORWARD_BURST;
+static constexpr int64_t kInterval = CONFIG_APP_STORE_FORWARD_BURST_INTERVAL_MS;
+
+BUILD_ASSERT(kPerPage >= 2, "page must hold several test datagrams");
+
+/**
+ * @brief Encode the datagram with header sequence number @p sequence
+ */
+static void makeDatagram(uint32_t sequence, uint8_t* out) {
+    WirePacketHeader header{};
+    header.device_id = 1;
+    header.boot_id = 0x5EED;
+    header.sequence = sequence;
+
+    WireSample sample{};
+    sample.sequence = sequence;
+    sample.timestamp_us = 1000ull * sequence;
+    sample.temperature = 2150;
+    sample.humidity = 4500;
+
+    zassert_equal(SensorProtocol::encode(header, &sample, 1, out, kDatagramSize),
+                  kDatagramSize);
+}
+
+/**
+ * @brief Offer datagrams [first, first + count) and store the refused ones
+ */
+static void transmit(UdpClient& client, DatagramStore& store, uint32_t first, size_t count) {
+    uint8_t buf[kDatagramSize];
+    for (uint32_t seq = first; seq < first + count; ++seq) {
+        makeDatagram(seq, buf);
+        if (client.send(buf, sizeof(buf)) != SendResult::kOk) {
+            zassert_true(store.append(buf, sizeof(buf)), "datagram %u not stored", seq);
+        }
+    }
+}
+
+/**
+ * @brief Run one backfill burst per interval until the store is empty
+ *
+ * @return Uptime after the last burst
+ */
+static int64_t drain(UdpClient& client, DatagramStore& store, int64_t now) {
+    for (size_t i = 0; store.pending() && i < FakeNetwork::kMaxSent; ++i) {
+        zassert_true(store.backfill(client, now) <= kBurst, "burst limit exceeded");
+        now += kInterval;
+    }
+    zassert_false(store.pending(), "store not drained");
+    return now;
+}
+
+/**
+ * @brief Check that the replayed datagrams are [first, first + count) in order
+ */
+static void expectReplayed(uint32_t first, size_t count) {
+    zassert_equal(fake_network.sent, count);
+    zassert_equal(fake_network.unflagged, 0, "replayed datagram without kFlagBackfill");
+    for (size_t i = 0; i < count; ++i) {
+        zassert_equal(fake_network.sequences[i], first + i, "datagram %u out of order",
+                      static_cast<unsigned>(i));
+    }
+}
+
+static void storeForwardBefore(void* fixture) {
+    ARG_UNUSED(fixture);
+
+    const struct flash_area* fa;
+    zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+    zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+    flash_area_close(fa);
+
+    fakeNetworkReset(0);
+}
+
+ZTEST_SUITE(store_forward, NULL, NULL, storeForwardBefore, NULL, NULL);
+
+/**
+ * Refused datagrams are stored with the backfill flag and stay queued while
+ * sends keep failing.
+ */
+ZTEST(store_forward, test_append_while_send_fails) {
+    UdpClient client("127.0.0.1", 8888);
+    DatagramStore store;
+    zassert_true(store.init());
+    zassert_false(store.pending());
+
+    const size_t count = kBurst < kPerPage ? kBurst : kPerPage - 1;
+    transmit(client, store, 0, count);
+    zassert_equal(fake_network.refused, count);
+    zassert_equal(store.stats().stored, count);
+    zassert_equal(store.stats().pages_written, 0, "page written before it was full");
+    zassert_true(store.pending());
+
+    // Still refused: nothing is replayed and nothing is lost
+    zassert_equal(store.backfill(client, 0), 0);
+    zassert_equal(store.stats().backfilled, 0);
+    zassert_true(store.pending());
+
+    fakeNetworkReset(SIZE_MAX);
+    zassert_equal(store.backfill(client, kInterval), count);
+    expectReplayed(0, count);
+    zassert_false(store.pending());
+}
+
+/**
+ * Datagrams are written one full page at a time; flash pages survive a
+ * reset, the partially filled RAM page does not.
+ */
+ZTEST(store_forward, test_page_batching) {
+    UdpClient client("127.0.0.1", 8888);
+    DatagramStore store;
+    zassert_true(store.init());
+
+    transmit(client, store, 0, kPerPage);
+    zassert_equal(store.stats().pages_written, 0);
+    transmit(client, store, kPerPage, 1);
+    zassert_equal(store.stats().pages_written, 1);
+    transmit(client, store, kPerPage + 1, 2 * kPerPage + 1);
+    zassert_equal(store.stats().pages_written, 3);
+    zassert_equal(store.stats().stored, 3 * kPerPage + 2);
+
+    DatagramStore rebooted;
+    zassert_true(rebooted.init());
+    zassert_true(rebooted.pending(), "flash pages lost on reset");
+
+    fakeNetworkReset(SIZE_MAX);
+    drain(client, rebooted, 0);
+    expectReplayed(0, 3 * kPerPage);
+}
+
+/**
+ * A full log erases its oldest sector; the newest datagrams are kept and
+ * replayed without gaps.
+ */
+ZTEST(store_forward, test_sector_rotation) {
+    UdpClient client("127.0.0.1", 8888);
+    DatagramStore store;
+    zassert_true(store.init());
+
+    uint32_t count = 0;
+    while (store.stats().overflows < 2 && count < FakeNetwork::kMaxSent) {
+        transmit(client, store, count, 1);
+        count++;
+    }
+    zassert_equal(store.stats().overflows, 2, "log never filled");
+
+    fakeNetworkReset(SIZE_MAX);
+    drain(client, store, 0);
+    const uint32_t first = fake_network.sequences[0];
+    zassert_true(first > 0, "oldest datagrams not given up");
+    expectReplayed(first, count - first);
+}
+
+/**
+ * Backfill replays oldest first, at most CONFIG_APP_STORE_FORWARD_BURST
+ * datagrams per CONFIG_APP_STORE_FORWARD_BURST_INTERVAL_MS, and retries a
+ * refused datagram with the next burst.
+ */
+ZTEST(store_forward, test_backfill_burst_limit) {
+    UdpClient client("127.0.0.1", 8888);
+    DatagramStore store;
+    zassert_true(store.init());
+
+    // Full flash pages and a partially filled RAM page
+    const size_t count = 2 * kPerPage + kBurst + 1;
+    transmit(client, store, 0, count);
+    zassert_equal(store.stats().pages_written, (count - 1) / kPerPage);
+
+    fakeNetworkReset(SIZE_MAX);
+    zassert_equal(store.backfill(client, 0), kBurst);
+    zassert_equal(store.nextBurst(), kInterval);
+    zassert_equal(store.backfill(client, kInterval - 1), 0, "burst before the interval");
+
+    fake_network.budget = 0;
+    zassert_equal(store.backfill(client, kInterval), 0);
+    zassert_equal(fake_network.refused, 1);
+
+    fake_network.budget = SIZE_MAX;
+    drain(client, store, 2 * kInterval);
+    expectReplayed(0, count);
+    zassert_equal(store.stats().backfilled, count);
+}